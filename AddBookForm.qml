@@ -11,6 +11,19 @@ Rectangle {
     
     signal bookAdded
     
+    // Books already in the catalog that look like the one being typed
+    property var similarBooks: []
+    
+    // Wait until typing pauses before checking for duplicates
+    Timer {
+        id: duplicateCheckTimer
+        interval: 300
+        repeat: false
+        onTriggered: {
+            similarBooks = duplicateDetector.findSimilar(titleField.text, authorField.text)
+        }
+    }
+    
     ColumnLayout {
         anchors.fill: parent
         anchors.margins: 20
@@ -54,6 +67,7 @@ Rectangle {
                         placeholderText: "Enter book title"
                         Layout.fillWidth: true
                         Layout.preferredHeight: 40
+                        onTextChanged: duplicateCheckTimer.restart()
                         
                         background: Rectangle {
                             border.color: "#d1d5db"
@@ -80,6 +94,7 @@ Rectangle {
                         placeholderText: "Enter author name"
                         Layout.fillWidth: true
                         Layout.preferredHeight: 40
+                        onTextChanged: duplicateCheckTimer.restart()
                         
                         background: Rectangle {
                             border.color: "#d1d5db"
@@ -180,6 +195,43 @@ Rectangle {
             }
         }
         
+        // Possible duplicate warning
+        Rectangle {
+            Layout.fillWidth: true
+            Layout.preferredHeight: duplicateCol.implicitHeight + 20
+            visible: similarBooks.length > 0
+            color: "#fef3c7"
+            border.color: "#f59e0b"
+            border.width: 1
+            radius: 6
+            
+            ColumnLayout {
+                id: duplicateCol
+                anchors.fill: parent
+                anchors.margins: 10
+                spacing: 4
+                
+                Text {
+                    text: "This book may already be in your library:"
+                    font.bold: true
+                    font.pixelSize: 12
+                    color: "#92400e"
+                }
+                
+                Repeater {
+                    model: similarBooks.slice(0, 3)
+                    
+                    Text {
+                        text: modelData.title + " by " + modelData.author + " (" + modelData.status + ")"
+                        font.pixelSize: 11
+                        color: "#78350f"
+                        elide: Text.ElideRight
+                        Layout.fillWidth: true
+                    }
+                }
+            }
+        }
+        
         // Action buttons
         RowLayout {
             Layout.fillWidth: true
@@ -224,6 +276,7 @@ Rectangle {
                     contactNameField.text = ""
                     contactNumberField.text = ""
                     statusCombo.currentIndex = 0
+                    similarBooks = []
                     
                     bookAdded()
                 }
@@ -256,6 +309,7 @@ Rectangle {
                     contactNameField.text = ""
                     contactNumberField.text = ""
                     statusCombo.currentIndex = 0
+                    similarBooks = []
                 }
             }
         }
@@ -0,0 +1,17 @@
+// Book.cpp
+// ============================================================================
+// Implementation of the Book value helpers
+// ============================================================================
+
+#include "Book.h"
+
+QString internStatus(const QString &status)
+{
+    static const QString shelf = QStringLiteral("SHELF");
+    static const QString loaned = QStringLiteral("LOANED");
+    static const QString borrowed = QStringLiteral("BORROWED");
+    if (status == shelf) return shelf;
+    if (status == loaned) return loaned;
+    if (status == borrowed) return borrowed;
+    return status;
+}
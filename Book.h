@@ -0,0 +1,28 @@
+// Book.h
+// ============================================================================
+// Purpose: The book record shared by the models, the catalog and the
+//          search/duplicate indexes
+// ============================================================================
+
+#ifndef BOOK_H
+#define BOOK_H
+
+#include <QString>
+
+// Book struct - represents a single book record
+struct Book {
+    int id;                    // Unique identifier for the book
+    QString title;             // Title of the book
+    QString author;            // Author name
+    QString status;            // Book status: SHELF, LOANED, BORROWED
+    QString contactName;       // Contact person if book is loaned/borrowed
+    QString contactNumber;     // Contact phone number
+};
+
+// internStatus: The shared instance for a known status value
+// Rows loaded from the database each carry a freshly allocated status
+// string; swapping it for the shared one lets that copy be freed, so a
+// large catalog keeps three status strings in memory instead of one per row
+QString internStatus(const QString &status);
+
+#endif // BOOK_H
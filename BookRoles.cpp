@@ -0,0 +1,40 @@
+// BookRoles.cpp
+// ============================================================================
+// Implementation of the shared Book model roles
+// ============================================================================
+
+#include "BookRoles.h"
+
+QVariant bookData(const Book &book, int role)
+{
+    switch (role) {
+    case BookIdRole:
+        return book.id;
+    case BookTitleRole:
+        return book.title;
+    case BookAuthorRole:
+        return book.author;
+    case BookStatusRole:
+        return book.status;
+    case BookContactNameRole:
+        return book.contactName;
+    case BookContactNumberRole:
+        return book.contactNumber;
+    default:
+        return QVariant();  // Unknown role
+    }
+}
+
+const QHash<int, QByteArray> &bookRoleNames()
+{
+    // Built once; views call roleNames() repeatedly
+    static const QHash<int, QByteArray> roles {
+        { BookIdRole, "id" },
+        { BookTitleRole, "title" },
+        { BookAuthorRole, "author" },
+        { BookStatusRole, "status" },
+        { BookContactNameRole, "contactName" },
+        { BookContactNumberRole, "contactNumber" }
+    };
+    return roles;
+}
@@ -0,0 +1,32 @@
+// BookRoles.h
+// ============================================================================
+// Purpose: Model roles for the Book fields, shared by every list model over
+//          books (LibraryModel and SearchModel)
+// ============================================================================
+
+#ifndef BOOKROLES_H
+#define BOOKROLES_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QVariant>
+#include "Book.h"
+
+// LibraryModel and SearchModel re-export these under their own enum names
+enum BookRole {
+    BookIdRole = Qt::UserRole + 1,
+    BookTitleRole,
+    BookAuthorRole,
+    BookStatusRole,
+    BookContactNameRole,
+    BookContactNumberRole
+};
+
+// bookData: Value of one BookRole for a book (invalid QVariant otherwise)
+// Strings are handed out as implicitly shared copies (reference count only)
+QVariant bookData(const Book &book, int role);
+
+// bookRoleNames: Role names for QML (model.title, model.author, ...)
+const QHash<int, QByteArray> &bookRoleNames();
+
+#endif // BOOKROLES_H
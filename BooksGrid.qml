@@ -12,6 +12,7 @@ Rectangle {
     // Signals to parent component
     signal editBookRequested(int bookId, string title, string author, string status, string contactName, string contactNumber)
     signal deleteBookRequested(int index)
+    signal findDuplicatesRequested
     
     // Property for the book model
     property var bookModel
@@ -67,6 +68,28 @@ Rectangle {
                 
                 Item { Layout.fillWidth: true }
                 
+                Button {
+                    text: "Find Duplicates"
+                    Layout.preferredHeight: 30
+                    
+                    background: Rectangle {
+                        color: "#f3f4f6"
+                        border.color: "#d1d5db"
+                        border.width: 1
+                        radius: 4
+                    }
+                    
+                    contentItem: Text {
+                        text: parent.text
+                        color: "#4b5563"
+                        horizontalAlignment: Text.AlignHCenter
+                        verticalAlignment: Text.AlignVCenter
+                        font.pixelSize: 11
+                    }
+                    
+                    onClicked: findDuplicatesRequested()
+                }
+                
                 Text {
                     text: "Use scroll to view more"
                     font.pixelSize: 11
@@ -85,6 +108,7 @@ Rectangle {
             
             GridView {
                 id: gridView
+                objectName: "booksGridView"  // Looked up by tests/tst_delegatebenchmark.cpp
                 model: bookModel
                 cellWidth: Math.max(250, parent.width / Math.max(2, Math.floor(parent.width / 280)))
                 cellHeight: 280
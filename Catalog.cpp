@@ -0,0 +1,132 @@
+// Catalog.cpp
+// ============================================================================
+// Implementation of chunked immutable snapshots and their publisher
+// ============================================================================
+
+#include "Catalog.h"
+#include <algorithm>
+
+// ============================================================================
+// CATALOG SNAPSHOT
+// ============================================================================
+
+// Constructor: Split the list into chunks of kChunkSize books
+CatalogSnapshot::CatalogSnapshot(const QList<Book> &books)
+    : m_count(int(books.count()))
+{
+    for (int start = 0; start < m_count; start += kChunkSize) {
+        m_offsets.append(start);
+        m_chunks.append(std::make_shared<const Chunk>(books.mid(start, kChunkSize)));
+    }
+}
+
+int CatalogSnapshot::chunkOf(int row) const
+{
+    // Last chunk whose first row is <= row
+    const auto it = std::upper_bound(m_offsets.cbegin(), m_offsets.cend(), row);
+    return qMax(0, int(it - m_offsets.cbegin()) - 1);
+}
+
+const Book &CatalogSnapshot::at(int row) const
+{
+    Q_ASSERT(row >= 0 && row < m_count);
+    const int chunk = chunkOf(row);
+    return m_chunks[chunk]->at(row - m_offsets[chunk]);
+}
+
+int CatalogSnapshot::indexOfId(int id) const
+{
+    int row = 0;
+    for (const ChunkPtr &chunk : m_chunks) {
+        for (const Book &book : *chunk) {
+            if (book.id == id)
+                return row;
+            row++;
+        }
+    }
+    return -1;
+}
+
+QList<Book> CatalogSnapshot::toList() const
+{
+    QList<Book> books;
+    books.reserve(m_count);
+    for (const ChunkPtr &chunk : m_chunks)
+        books.append(*chunk);
+    return books;
+}
+
+CatalogSnapshotPtr CatalogSnapshot::withChunks(QList<ChunkPtr> chunks)
+{
+    auto snapshot = std::make_shared<CatalogSnapshot>();
+    snapshot->m_chunks = std::move(chunks);
+    for (const ChunkPtr &chunk : snapshot->m_chunks) {
+        snapshot->m_offsets.append(snapshot->m_count);
+        snapshot->m_count += int(chunk->count());
+    }
+    return snapshot;
+}
+
+// replaced: Copy only the chunk that holds the row
+CatalogSnapshotPtr CatalogSnapshot::replaced(int row, const Book &book) const
+{
+    Q_ASSERT(row >= 0 && row < m_count);
+    const int chunk = chunkOf(row);
+
+    Chunk copy = *m_chunks[chunk];
+    copy[row - m_offsets[chunk]] = book;
+
+    QList<ChunkPtr> chunks = m_chunks;
+    chunks[chunk] = std::make_shared<const Chunk>(std::move(copy));
+    return withChunks(std::move(chunks));
+}
+
+// inserted: Copy the target chunk, splitting it once it grows too large
+CatalogSnapshotPtr CatalogSnapshot::inserted(int row, const Book &book) const
+{
+    Q_ASSERT(row >= 0 && row <= m_count);
+    QList<ChunkPtr> chunks = m_chunks;
+
+    if (chunks.isEmpty()) {
+        chunks.append(std::make_shared<const Chunk>(Chunk{ book }));
+        return withChunks(std::move(chunks));
+    }
+
+    const int chunk = chunkOf(row);
+    Chunk copy = *m_chunks[chunk];
+    copy.insert(row - m_offsets[chunk], book);
+
+    if (copy.count() >= 2 * kChunkSize) {
+        chunks[chunk] = std::make_shared<const Chunk>(copy.first(kChunkSize));
+        chunks.insert(chunk + 1, std::make_shared<const Chunk>(copy.sliced(kChunkSize)));
+    } else {
+        chunks[chunk] = std::make_shared<const Chunk>(std::move(copy));
+    }
+    return withChunks(std::move(chunks));
+}
+
+// removed: Copy the target chunk, dropping it when it becomes empty
+CatalogSnapshotPtr CatalogSnapshot::removed(int row) const
+{
+    Q_ASSERT(row >= 0 && row < m_count);
+    const int chunk = chunkOf(row);
+
+    Chunk copy = *m_chunks[chunk];
+    copy.removeAt(row - m_offsets[chunk]);
+
+    QList<ChunkPtr> chunks = m_chunks;
+    if (copy.isEmpty())
+        chunks.removeAt(chunk);
+    else
+        chunks[chunk] = std::make_shared<const Chunk>(std::move(copy));
+    return withChunks(std::move(chunks));
+}
+
+// ============================================================================
+// CATALOG (PUBLISHER)
+// ============================================================================
+
+Catalog::Catalog()
+    : m_current(std::make_shared<const CatalogSnapshot>())
+{
+}
@@ -0,0 +1,159 @@
+// Catalog.h
+// ============================================================================
+// Purpose: Immutable, versioned book lists that any thread can read
+// Responsibilities:
+//   - CatalogSnapshot: a frozen list of books stored in fixed-size chunks.
+//     Edits produce a new snapshot that shares every untouched chunk, so a
+//     single-row change copies one chunk plus the chunk pointer table.
+//   - AtomicVersion: the atomic shared pointer behind Catalog, also used to
+//     publish objects derived from a snapshot (SearchIndex)
+//   - Catalog: publishes the current snapshot through an atomic shared
+//     pointer (RCU style). Readers take the current version and keep using
+//     it for as long as they hold it; a version is freed when its last
+//     reader lets go. Readers never wait for the writer to build a version
+//     or for the model to notify its views.
+// Threading: one writer (the GUI thread that owns the model), any number
+//            of readers on any thread.
+// Note: this is not lock-free. std::atomic<std::shared_ptr> guards the
+//       pointer swap and reference count bump with a short internal lock
+//       (is_lock_free() is false in libstdc++ and MSVC), so a load or store
+//       can briefly wait on another one, never on the work around it.
+// ============================================================================
+
+#ifndef CATALOG_H
+#define CATALOG_H
+
+#include <QList>
+#include <atomic>
+#include <memory>
+#include "Book.h"
+
+class CatalogSnapshot;
+using CatalogSnapshotPtr = std::shared_ptr<const CatalogSnapshot>;
+
+class CatalogSnapshot
+{
+public:
+    // Target number of books per chunk; chunks split at twice this size
+    static constexpr int kChunkSize = 64;
+
+    // Constructors: empty, or chunked from a plain list
+    CatalogSnapshot() = default;
+    explicit CatalogSnapshot(const QList<Book> &books);
+
+    int count() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+
+    // at: Book at a row (O(log chunks))
+    const Book &at(int row) const;
+
+    // indexOfId: Row of the book with this database id, or -1
+    int indexOfId(int id) const;
+
+    // toList: Flat copy (shares the strings)
+    QList<Book> toList() const;
+
+    // forEach: Visit every book in row order without flattening
+    template <typename Function>
+    void forEach(Function function) const
+    {
+        for (const ChunkPtr &chunk : m_chunks) {
+            for (const Book &book : *chunk)
+                function(book);
+        }
+    }
+
+    // ========== Persistent Edits ==========
+    // Each returns a new snapshot; this one is left unchanged
+
+    CatalogSnapshotPtr replaced(int row, const Book &book) const;
+    CatalogSnapshotPtr inserted(int row, const Book &book) const;
+    CatalogSnapshotPtr removed(int row) const;
+
+private:
+    using Chunk = QList<Book>;
+    using ChunkPtr = std::shared_ptr<const Chunk>;
+
+    // m_chunks: Immutable chunks, possibly shared with other snapshots
+    QList<ChunkPtr> m_chunks;
+
+    // m_offsets: Row number of the first book of each chunk
+    QList<int> m_offsets;
+
+    int m_count = 0;
+
+    // chunkOf: Chunk holding a row (row may equal count() for appends)
+    int chunkOf(int row) const;
+
+    // withChunks: Snapshot over a new chunk table, recomputing offsets
+    static CatalogSnapshotPtr withChunks(QList<ChunkPtr> chunks);
+};
+
+// AtomicVersion: Holder for the current version of an immutable object
+// Readers load() a shared pointer and keep it as long as they need; the
+// writer store()s a replacement. A version is freed with its last holder.
+template <typename T>
+class AtomicVersion
+{
+public:
+    using Ptr = std::shared_ptr<const T>;
+
+    explicit AtomicVersion(Ptr initial = Ptr())
+        : m_current(std::move(initial))
+    {
+    }
+
+    AtomicVersion(const AtomicVersion &) = delete;
+    AtomicVersion &operator=(const AtomicVersion &) = delete;
+
+    // load: Current version; safe to call from any thread
+    Ptr load() const
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return m_current.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&m_current, std::memory_order_acquire);
+#endif
+    }
+
+    // store: Replace the current version (writer thread only)
+    // Readers still holding the previous version are unaffected
+    void store(Ptr version)
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        m_current.store(std::move(version), std::memory_order_release);
+#else
+        std::atomic_store_explicit(&m_current, std::move(version), std::memory_order_release);
+#endif
+    }
+
+private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<Ptr> m_current;
+#else
+    // Standard libraries without atomic<shared_ptr> yet (libc++): the
+    // std::atomic_load/atomic_store overloads, backed by a global lock pool
+    Ptr m_current;
+#endif
+};
+
+class Catalog
+{
+public:
+    Catalog();
+
+    Catalog(const Catalog &) = delete;
+    Catalog &operator=(const Catalog &) = delete;
+
+    // snapshot: Current version; safe to call from any thread
+    CatalogSnapshotPtr snapshot() const { return m_current.load(); }
+
+    // publish: Replace the current version (writer thread only)
+    // Readers still holding the previous version are unaffected
+    void publish(CatalogSnapshotPtr snapshot) { m_current.store(std::move(snapshot)); }
+
+private:
+    AtomicVersion<CatalogSnapshot> m_current;
+};
+
+#endif // CATALOG_H
@@ -53,3 +53,15 @@ QSqlDatabase DatabaseManager::db() const
 {
     return m_db;
 }
+
+Book DatabaseManager::bookFromQuery(const QSqlQuery &query)
+{
+    Book book;
+    book.id = query.value(0).toInt();
+    book.title = query.value(1).toString();
+    book.author = query.value(2).toString();
+    book.status = internStatus(query.value(3).toString());
+    book.contactName = query.value(4).toString();
+    book.contactNumber = query.value(5).toString();
+    return book;
+}
@@ -6,6 +6,7 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
+#include "Book.h"
 
 class DatabaseManager : public QObject
 {
@@ -17,6 +18,10 @@ public:
     bool connectToDatabase();
     QSqlDatabase db() const;
 
+    // Reads the current row of a query selecting
+    // id, title, author, status, contact_name, contact_number (in that order)
+    static Book bookFromQuery(const QSqlQuery &query);
+
 private:
     QSqlDatabase m_db;
 };
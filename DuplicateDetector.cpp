@@ -0,0 +1,421 @@
+// DuplicateDetector.cpp
+// ============================================================================
+// Implementation of MinHash/LSH near-duplicate detection for the catalog
+// ============================================================================
+
+#include "DuplicateDetector.h"
+#include <QSet>
+#include <QStringList>
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace {
+
+// splitmix64: Cheap, well-distributed 64-bit mixer used to derive the
+// independent hash functions of the MinHash family from one base hash
+quint64 splitmix64(quint64 x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// fnv1a: Base hash of one shingle (a short run of UTF-16 code units)
+quint64 fnv1a(QStringView text)
+{
+    quint64 hash = 0xcbf29ce484222325ULL;
+    for (QChar c : text) {
+        hash ^= c.unicode();
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Leading articles that are commonly dropped or moved ("Hobbit, The")
+const QStringList &articles()
+{
+    static const QStringList list = { "the", "a", "an" };
+    return list;
+}
+
+// Volume markers: a title containing one of these is a different book from
+// the same title with another (or no) marker
+bool isVolumeWord(const QString &word)
+{
+    static const QStringList romanNumerals = {
+        "i", "ii", "iii", "iv", "v", "vi", "vii", "viii", "ix", "x", "xi", "xii"
+    };
+    if (romanNumerals.contains(word))
+        return true;
+    for (QChar c : word) {
+        if (!c.isDigit())
+            return false;
+    }
+    return true;
+}
+
+// simplifyText: Strip accents and punctuation, lower-case, split into words
+QStringList simplifyText(const QString &text)
+{
+    const QString decomposed = text.normalized(QString::NormalizationForm_KD);
+    QString cleaned;
+    cleaned.reserve(decomposed.size());
+    for (QChar c : decomposed) {
+        if (c.category() == QChar::Mark_NonSpacing)
+            continue;  // Drop combining accents: "é" -> "e"
+        if (c == QChar('\'') || c == QChar(0x2019))
+            continue;  // Keep "Salem's" one word: "salems"
+        cleaned.append(c.isLetterOrNumber() ? c.toLower() : QChar(' '));
+    }
+    return cleaned.split(' ', Qt::SkipEmptyParts);
+}
+
+// Shingle width in characters; 3 keeps short titles distinguishable
+constexpr int kShingleSize = 3;
+
+// shingleHashes: Sorted, distinct hashes of the text's shingles
+// The text is padded with spaces so that short words still get shingles of
+// their own ("it" -> " it", "it ") instead of one shared by every short title
+QList<quint64> shingleHashes(const QString &text)
+{
+    QList<quint64> hashes;
+    if (text.isEmpty())
+        return hashes;
+
+    const QString padded = ' ' + text + ' ';
+    for (int i = 0; i + kShingleSize <= padded.size(); ++i)
+        hashes.append(fnv1a(QStringView(padded).mid(i, kShingleSize)));
+
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    return hashes;
+}
+
+// jaccard: |A ∩ B| / |A ∪ B| of two sorted, distinct hash lists
+double jaccard(const QList<quint64> &a, const QList<quint64> &b)
+{
+    if (a.isEmpty() && b.isEmpty())
+        return 1.0;
+
+    int common = 0;
+    auto i = a.cbegin();
+    auto j = b.cbegin();
+    while (i != a.cend() && j != b.cend()) {
+        if (*i < *j) {
+            ++i;
+        } else if (*j < *i) {
+            ++j;
+        } else {
+            ++common;
+            ++i;
+            ++j;
+        }
+    }
+    return double(common) / (a.count() + b.count() - common);
+}
+
+} // namespace
+
+// ============================================================================
+// CONSTRUCTOR
+// ============================================================================
+DuplicateDetector::DuplicateDetector(QObject *parent)
+    : QObject(parent)
+    , m_snapshot(std::make_shared<const CatalogSnapshot>())
+{
+}
+
+// ============================================================================
+// KEY NORMALIZATION AND SIGNATURES
+// ============================================================================
+
+QString DuplicateDetector::normalizeTitle(const QString &title)
+{
+    QStringList words = simplifyText(title);
+    if (words.size() > 1 && articles().contains(words.first()))
+        words.removeFirst();
+    if (words.size() > 1 && articles().contains(words.last()))
+        words.removeLast();
+    return words.join(' ');
+}
+
+QString DuplicateDetector::normalizeAuthor(const QString &author)
+{
+    // Author name order varies ("King, Stephen"), so compare the sorted words
+    QStringList words = simplifyText(author);
+    std::sort(words.begin(), words.end());
+    return words.join(' ');
+}
+
+// computeSignature: For each of the kSignatureSize hash functions keep the
+// minimum hash over all shingles of the key
+DuplicateDetector::Signature DuplicateDetector::computeSignature(const QString &key)
+{
+    Signature signature;
+    signature.fill(std::numeric_limits<quint32>::max());
+
+    for (quint64 base : shingleHashes(key)) {
+        for (int h = 0; h < kSignatureSize; ++h) {
+            const quint32 value = quint32(splitmix64(base ^ (quint64(h) * 0x9e3779b97f4a7c15ULL)));
+            if (value < signature[h])
+                signature[h] = value;
+        }
+    }
+    return signature;
+}
+
+// fingerprint: The title and author are scored separately; mixing them into
+// one shingle set let a shared author outweigh two unrelated short titles
+DuplicateDetector::Fingerprint DuplicateDetector::fingerprint(const QString &title, const QString &author)
+{
+    const QString titleKey = normalizeTitle(title);
+
+    Fingerprint result;
+    result.titleSignature = computeSignature(titleKey);
+    result.titleShingles = shingleHashes(titleKey);
+    result.authorShingles = shingleHashes(normalizeAuthor(author));
+
+    for (const QString &word : titleKey.split(' ', Qt::SkipEmptyParts)) {
+        if (isVolumeWord(word))
+            result.volumes.append(word);
+    }
+    result.volumes.sort();
+    return result;
+}
+
+double DuplicateDetector::matchScore(const Fingerprint &a, const Fingerprint &b, bool allowMissingAuthor)
+{
+    // "Dark Tower" / "Dark Tower II" / "Dark Tower 3" are different books
+    if (a.volumes != b.volumes)
+        return 0.0;
+
+    const bool authorMissing = a.authorShingles.isEmpty() || b.authorShingles.isEmpty();
+    if (!(allowMissingAuthor && authorMissing)
+        && jaccard(a.authorShingles, b.authorShingles) < kAuthorThreshold)
+        return 0.0;
+
+    // Titles that normalize to nothing ("!!!") say nothing about identity
+    if (a.titleShingles.isEmpty() || b.titleShingles.isEmpty())
+        return 0.0;
+
+    return jaccard(a.titleShingles, b.titleShingles);
+}
+
+quint64 DuplicateDetector::bandKey(const Signature &signature, int band, int rowsPerBand)
+{
+    quint64 key = splitmix64(quint64(band));
+    for (int r = 0; r < rowsPerBand; ++r)
+        key = splitmix64(key ^ signature[band * rowsPerBand + r]);
+    return key;
+}
+
+// ============================================================================
+// INDEX MAINTENANCE
+// ============================================================================
+
+// setSnapshot: Only records the version; see ensureIndexed()
+void DuplicateDetector::setSnapshot(CatalogSnapshotPtr snapshot)
+{
+    m_pending = std::move(snapshot);
+}
+
+// ensureIndexed: O(n) re-index of the whole catalog (buckets are over
+// titles), but shingles and MinHash signatures, the costly part, are only
+// computed for books that are new or were edited since the last index
+void DuplicateDetector::ensureIndexed()
+{
+    if (!m_pending)
+        return;
+
+    // Entries are in snapshot order, so a book's row is its entry index
+    QHash<int, int> previousRows;
+    previousRows.reserve(m_snapshot->count());
+    int previousRow = 0;
+    m_snapshot->forEach([&previousRows, &previousRow](const Book &book) {
+        previousRows.insert(book.id, previousRow++);
+    });
+
+    const CatalogSnapshotPtr previous = std::exchange(m_snapshot, std::move(m_pending));
+    const QList<Entry> previousEntries = std::exchange(m_entries, QList<Entry>());
+    m_buckets.clear();
+    m_typingBuckets.clear();
+    m_entries.reserve(m_snapshot->count());
+
+    int row = 0;
+    m_snapshot->forEach([&](const Book &book) {
+        Entry entry;
+        entry.row = row;
+
+        const auto it = previousRows.constFind(book.id);
+        if (it != previousRows.constEnd() && previous->at(*it).title == book.title
+            && previous->at(*it).author == book.author)
+            entry.fingerprint = previousEntries[*it].fingerprint;
+        else
+            entry.fingerprint = fingerprint(book.title, book.author);
+
+        const int index = m_entries.count();
+        for (int band = 0; band < kBands; ++band)
+            m_buckets[bandKey(entry.fingerprint.titleSignature, band, kRowsPerBand)].append(index);
+        for (int band = 0; band < kTypingBands; ++band)
+            m_typingBuckets[bandKey(entry.fingerprint.titleSignature, band, kTypingRowsPerBand)].append(index);
+        m_entries.append(entry);
+        row++;
+    });
+}
+
+QList<int> DuplicateDetector::typingCandidates(const Signature &signature) const
+{
+    QSet<int> seen;
+    QList<int> candidates;
+    for (int band = 0; band < kTypingBands; ++band) {
+        const auto it = m_typingBuckets.constFind(bandKey(signature, band, kTypingRowsPerBand));
+        if (it == m_typingBuckets.constEnd())
+            continue;
+        for (int index : *it) {
+            if (!seen.contains(index)) {
+                seen.insert(index);
+                candidates.append(index);
+            }
+        }
+    }
+    return candidates;
+}
+
+QVariantMap DuplicateDetector::bookToVariant(int entry) const
+{
+    const Book &book = m_snapshot->at(m_entries[entry].row);
+    QVariantMap map;
+    map["id"] = book.id;
+    map["title"] = book.title;
+    map["author"] = book.author;
+    map["status"] = book.status;
+    return map;
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+// findSimilar: Only books sharing a typing-layout bucket with the typed
+// title are scored, so this stays cheap regardless of catalog size
+QVariantList DuplicateDetector::findSimilar(const QString &title, const QString &author)
+{
+    if (title.trimmed().isEmpty())
+        return QVariantList();
+
+    ensureIndexed();
+
+    const Fingerprint typed = fingerprint(title, author);
+
+    QList<QPair<double, int>> matches;
+    for (int index : typingCandidates(typed.titleSignature)) {
+        const double score = matchScore(typed, m_entries[index].fingerprint, true);
+        if (score >= kTypingThreshold)
+            matches.append(qMakePair(score, index));
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const auto &a, const auto &b) {
+        return a.first > b.first;
+    });
+
+    QVariantList result;
+    for (const auto &match : matches) {
+        QVariantMap map = bookToVariant(match.second);
+        map["score"] = match.first;
+        result.append(map);
+    }
+    return result;
+}
+
+// scanCatalog: Verify every pair that shares a bucket and join confirmed
+// pairs with union-find. Work is proportional to the bucket sizes, not n².
+// Similarity is not transitive (A~B and B~C does not mean A~C), so each
+// union-find component is then split into stars around a keeper: a member
+// is only listed if it matches the keeper itself, because merging folds
+// every listed member into the keeper and deletes it.
+QVariantList DuplicateDetector::scanCatalog()
+{
+    ensureIndexed();
+
+    const int count = m_entries.count();
+    QList<int> parent(count);
+    for (int i = 0; i < count; ++i)
+        parent[i] = i;
+
+    auto find = [&parent](int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];  // Path halving
+            x = parent[x];
+        }
+        return x;
+    };
+
+    for (const QList<int> &bucket : m_buckets) {
+        for (int i = 0; i < bucket.count(); ++i) {
+            for (int j = i + 1; j < bucket.count(); ++j) {
+                const int a = find(bucket[i]);
+                const int b = find(bucket[j]);
+                if (a == b)
+                    continue;  // Already known to be in the same component
+
+                const double score = matchScore(m_entries[bucket[i]].fingerprint,
+                                                m_entries[bucket[j]].fingerprint, false);
+                if (score >= kBatchThreshold)
+                    parent[b] = a;
+            }
+        }
+    }
+
+    QHash<int, QList<int>> components;
+    for (int i = 0; i < count; ++i)
+        components[find(i)].append(i);
+
+    QVariantList report;
+    for (auto it = components.begin(); it != components.end(); ++it) {
+        QList<int> remaining = it.value();
+        if (remaining.count() < 2)
+            continue;
+
+        // Oldest record (lowest id) first, so it becomes the keeper
+        std::sort(remaining.begin(), remaining.end(), [&](int a, int b) {
+            return m_snapshot->at(m_entries[a].row).id < m_snapshot->at(m_entries[b].row).id;
+        });
+
+        // Peel off one star per keeper; members that do not match this
+        // keeper are tried against the next one
+        while (remaining.count() >= 2) {
+            const int keeper = remaining.takeFirst();
+            const Fingerprint &keeperFingerprint = m_entries[keeper].fingerprint;
+
+            QVariantList groupBooks = { bookToVariant(keeper) };
+            double groupScore = 1.0;
+            QList<int> unmatched;
+            for (int member : remaining) {
+                const double score = matchScore(keeperFingerprint, m_entries[member].fingerprint, false);
+                if (score < kBatchThreshold) {
+                    unmatched.append(member);
+                    continue;
+                }
+                QVariantMap book = bookToVariant(member);
+                book["score"] = score;
+                groupBooks.append(book);
+                groupScore = qMin(groupScore, score);
+            }
+            remaining = unmatched;
+
+            if (groupBooks.count() < 2)
+                continue;
+
+            QVariantMap group;
+            group["score"] = groupScore;
+            group["books"] = groupBooks;
+            report.append(group);
+        }
+    }
+
+    qDebug() << "Duplicate scan:" << count << "books," << report.count() << "duplicate groups";
+    return report;
+}
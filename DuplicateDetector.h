@@ -0,0 +1,145 @@
+// DuplicateDetector.h
+// ============================================================================
+// Purpose: Finds books that were entered more than once with slightly
+//          different spelling ("The Dark Tower" / "Dark Tower, The")
+// Responsibilities:
+//   - Normalizes titles and authors into comparable forms
+//   - Builds MinHash signatures over character shingles of the title
+//   - Buckets signatures with locality-sensitive hashing (LSH) so that only
+//     books sharing a bucket are ever compared (no all-pairs scan)
+//   - Confirms candidates with the exact title similarity, a matching author
+//     and identical volume numbers ("Dark Tower" is not "Dark Tower II")
+//   - Answers "does this look like something we already have?" while typing
+//   - Runs a whole-catalog pass that groups likely duplicates for merging
+// ============================================================================
+
+#ifndef DUPLICATEDETECTOR_H
+#define DUPLICATEDETECTOR_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+#include <array>
+#include "Catalog.h"
+
+class DuplicateDetector : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Signature layout: kSignatureSize MinHash values, cut into bands in two
+    // ways. Two titles share an LSH bucket if any band matches exactly.
+    //   - Merge scan: 8 bands of 4 rows. Pairs at similarity 0.8 share a
+    //     bucket ~99% of the time, pairs at 0.5 only ~40%, which keeps the
+    //     number of pairs verified by scanCatalog small.
+    //   - Typing: 16 bands of 2 rows. Pairs at the 0.5 warning threshold
+    //     share a bucket ~99% of the time (0.4: ~94%), so findSimilar does
+    //     not miss warnings; it verifies more candidates, but for one title.
+    static constexpr int kBands = 8;
+    static constexpr int kRowsPerBand = 4;
+    static constexpr int kTypingBands = 16;
+    static constexpr int kTypingRowsPerBand = 2;
+    static constexpr int kSignatureSize = kBands * kRowsPerBand;
+    static_assert(kTypingBands * kTypingRowsPerBand == kSignatureSize);
+
+    using Signature = std::array<quint32, kSignatureSize>;
+
+    // Constructor: Starts with an empty catalog; call setSnapshot() with
+    // every catalog version to keep the index in sync (see main.cpp)
+    explicit DuplicateDetector(QObject *parent = nullptr);
+
+    // findSimilar: Books in the catalog that probably match the given
+    // title/author. Used by AddBookForm while the user is typing.
+    // Returns: list of { id, title, author, status, score } sorted by score
+    Q_INVOKABLE QVariantList findSimilar(const QString &title, const QString &author);
+
+    // scanCatalog: Whole-catalog batch pass.
+    // Returns: list of groups { score, books: [ { id, title, author, status } ] }
+    //          where the first book in each group is the suggested keeper.
+    //          Every other book matches the keeper directly and carries its
+    //          own "score" against it; the group score is the lowest of them.
+    Q_INVOKABLE QVariantList scanCatalog();
+
+    // Fingerprint: Everything needed to compare one book with another
+    struct Fingerprint {
+        Signature titleSignature;       // MinHash of the title, for LSH buckets
+        QList<quint64> titleShingles;   // Sorted, distinct shingle hashes
+        QList<quint64> authorShingles;  // Sorted, distinct shingle hashes
+        QStringList volumes;            // Numbers/roman numerals in the title
+    };
+
+    // normalizeTitle: Lower-cased, accent-free, punctuation-free words with
+    // a leading or trailing article dropped ("Hobbit, The" -> "hobbit")
+    static QString normalizeTitle(const QString &title);
+
+    // normalizeAuthor: Same cleanup with the name words sorted, so
+    // "King, Stephen" and "Stephen King" compare equal
+    static QString normalizeAuthor(const QString &author);
+
+    // fingerprint: Normalize and hash one title/author pair
+    static Fingerprint fingerprint(const QString &title, const QString &author);
+
+    // matchScore: Exact Jaccard similarity of the two titles' shingles, or 0
+    // when the volume numbers differ or the authors do not match.
+    // With allowMissingAuthor an empty author on either side is not checked
+    // (the add form warns before the author has been typed).
+    static double matchScore(const Fingerprint &a, const Fingerprint &b, bool allowMissingAuthor);
+
+    // Minimum matchScore to warn while typing / to offer a merge.
+    // The merge threshold stays above what an extra word or volume suffix
+    // scores on short titles; volume numbers are checked separately.
+    static constexpr double kTypingThreshold = 0.5;
+    static constexpr double kBatchThreshold = 0.8;
+
+    // Minimum author shingle similarity for two authors to match
+    // (tolerates a typo, not a different person)
+    static constexpr double kAuthorThreshold = 0.7;
+
+    // setSnapshot: Catalog version to answer from. Indexed on the next
+    // query, so a burst of edits costs one re-index; books whose title and
+    // author did not change keep their fingerprints from the previous index.
+    void setSnapshot(CatalogSnapshotPtr snapshot);
+
+private:
+    // Indexed entry for one book (row refers to m_snapshot)
+    struct Entry {
+        int row;
+        Fingerprint fingerprint;
+    };
+
+    // m_snapshot: Catalog version the index was built from
+    CatalogSnapshotPtr m_snapshot;
+
+    // m_pending: Newer version passed to setSnapshot(), not indexed yet
+    CatalogSnapshotPtr m_pending;
+
+    // m_entries: One entry per book, in snapshot order
+    QList<Entry> m_entries;
+
+    // m_buckets / m_typingBuckets: LSH bucket key (band hash mixed with
+    // band number) -> entries, for the merge and typing band layouts
+    QHash<quint64, QList<int>> m_buckets;
+    QHash<quint64, QList<int>> m_typingBuckets;
+
+    // ensureIndexed: Index m_pending, if any, before answering a query
+    void ensureIndexed();
+
+    // computeSignature: MinHash signature of a key's character shingles
+    static Signature computeSignature(const QString &key);
+
+    // bandKey: Hash of one band of a signature, unique per band number
+    static quint64 bandKey(const Signature &signature, int band, int rowsPerBand);
+
+    // typingCandidates: Entries sharing at least one typing-layout bucket
+    // with a signature
+    QList<int> typingCandidates(const Signature &signature) const;
+
+    // bookToVariant: QML-friendly description of one indexed book
+    QVariantMap bookToVariant(int entry) const;
+};
+
+#endif // DUPLICATEDETECTOR_H
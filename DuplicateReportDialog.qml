@@ -0,0 +1,141 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+
+// DuplicateReportDialog.qml
+// Lists groups of likely duplicate books found by the catalog scan
+// The first book of each group is kept; merging folds the others into it
+// (each of them was compared with the kept book itself)
+
+Dialog {
+    id: duplicateDialog
+
+    // Groups returned by duplicateDetector.scanCatalog()
+    property var report: []
+
+    // Signals emitted to parent
+    signal mergeRequested(int keepId, var duplicateIds)
+
+    // Merging deletes records, so every merge is confirmed first
+    Dialog {
+        id: mergeConfirmDialog
+        title: "Confirm Merge"
+        standardButtons: Dialog.Yes | Dialog.No
+        parent: Overlay.overlay
+        anchors.centerIn: parent
+        width: 380
+        height: 170
+
+        property int keepId: -1
+        property var duplicateIds: []
+        property string keepTitle: ""
+
+        Text {
+            text: "Merge " + mergeConfirmDialog.duplicateIds.length + " record(s) into \"" +
+                  mergeConfirmDialog.keepTitle + "\"? The merged records will be deleted."
+            wrapMode: Text.Wrap
+            anchors.fill: parent
+            anchors.margins: 15
+            verticalAlignment: Text.AlignVCenter
+        }
+
+        onAccepted: mergeRequested(keepId, duplicateIds)
+    }
+
+    // Dialog configuration
+    width: 520
+    height: 560
+    title: "Possible Duplicates (" + report.length + ")"
+    standardButtons: Dialog.Close
+
+    Text {
+        anchors.centerIn: parent
+        visible: report.length === 0
+        text: "No duplicates found."
+        font.pixelSize: 13
+        color: "#6b7280"
+    }
+
+    ListView {
+        anchors.fill: parent
+        visible: report.length > 0
+        clip: true
+        spacing: 10
+        model: report
+
+        ScrollBar.vertical: ScrollBar { policy: ScrollBar.AsNeeded }
+
+        delegate: Rectangle {
+            width: ListView.view.width - 12
+            height: groupCol.implicitHeight + 20
+            color: "#ffffff"
+            border.color: "#e5e7eb"
+            border.width: 1
+            radius: 6
+
+            ColumnLayout {
+                id: groupCol
+                anchors.fill: parent
+                anchors.margins: 10
+                spacing: 4
+
+                Repeater {
+                    model: modelData.books
+
+                    Text {
+                        text: (index === 0 ? "Keep: " : "Merge: ") + modelData.title +
+                              " by " + modelData.author + " (" + modelData.status + ")" +
+                              (index === 0 ? "" : " - " + Math.round(modelData.score * 100) + "%")
+                        font.bold: index === 0
+                        font.pixelSize: 11
+                        color: index === 0 ? "#1f2937" : "#6b7280"
+                        elide: Text.ElideRight
+                        Layout.fillWidth: true
+                    }
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+
+                    Text {
+                        text: "Lowest similarity to keeper " + Math.round(modelData.score * 100) + "%"
+                        font.pixelSize: 10
+                        color: "#9ca3af"
+                    }
+
+                    Item { Layout.fillWidth: true }
+
+                    Button {
+                        text: "Merge"
+                        Layout.preferredHeight: 30
+
+                        background: Rectangle {
+                            color: "#f59e0b"
+                            radius: 4
+                        }
+
+                        contentItem: Text {
+                            text: parent.text
+                            color: "#ffffff"
+                            horizontalAlignment: Text.AlignHCenter
+                            verticalAlignment: Text.AlignVCenter
+                            font.pixelSize: 11
+                        }
+
+                        onClicked: {
+                            let books = modelData.books
+                            let duplicateIds = []
+                            for (let i = 1; i < books.length; i++) {
+                                duplicateIds.push(books[i].id)
+                            }
+                            mergeConfirmDialog.keepId = books[0].id
+                            mergeConfirmDialog.keepTitle = books[0].title
+                            mergeConfirmDialog.duplicateIds = duplicateIds
+                            mergeConfirmDialog.open()
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
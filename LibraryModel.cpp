@@ -6,6 +6,7 @@
 
 LibraryModel::LibraryModel(QObject *parent)
     : QAbstractListModel(parent)
+    , m_books(m_catalog.snapshot())
 {
     refresh();
 }
@@ -14,78 +15,82 @@ int LibraryModel::rowCount(const QModelIndex &parent) const
 {
     if (parent.isValid())
         return 0;
-    return m_books.count();
+    return m_books->count();
 }
 
 QVariant LibraryModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_books.count())
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_books->count())
         return QVariant();
 
-    const Book &book = m_books[index.row()];
-
-    switch (role) {
-    case IdRole:
-        return book.id;
-    case TitleRole:
-        return book.title;
-    case AuthorRole:
-        return book.author;
-    case StatusRole:
-        return book.status;
-    case ContactNameRole:
-        return book.contactName;
-    case ContactNumberRole:
-        return book.contactNumber;
-    default:
-        return QVariant();
+    return bookData(m_books->at(index.row()), role);
+}
+
+// Delegates ask for all of their roles at once; fill them in a single call
+// with one bounds check and one row lookup instead of one data() per role.
+void LibraryModel::multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_books->count()) {
+        for (QModelRoleData &roleData : roleDataSpan)
+            roleData.clearData();
+        return;
     }
+
+    const Book &book = m_books->at(index.row());
+    for (QModelRoleData &roleData : roleDataSpan)
+        roleData.setData(bookData(book, roleData.role()));
 }
 
 QHash<int, QByteArray> LibraryModel::roleNames() const
 {
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";
-    roles[TitleRole] = "title";
-    roles[AuthorRole] = "author";
-    roles[StatusRole] = "status";
-    roles[ContactNameRole] = "contactName";
-    roles[ContactNumberRole] = "contactNumber";
-    return roles;
+    return bookRoleNames();
 }
 
-void LibraryModel::refresh()
+void LibraryModel::publish(CatalogSnapshotPtr snapshot)
 {
-    beginResetModel();
-    m_books.clear();
+    m_books = snapshot;
+    m_catalog.publish(std::move(snapshot));
+}
 
+void LibraryModel::refresh()
+{
+    QList<Book> books;
     QSqlQuery query("SELECT id, title, author, status, contact_name, contact_number FROM books ORDER BY id DESC");
-    while (query.next()) {
-        Book book;
-        book.id = query.value(0).toInt();
-        book.title = query.value(1).toString();
-        book.author = query.value(2).toString();
-        book.status = query.value(3).toString();
-        book.contactName = query.value(4).toString();
-        book.contactNumber = query.value(5).toString();
-        m_books.append(book);
-    }
+    while (query.next())
+        books.append(DatabaseManager::bookFromQuery(query));
+
+    beginResetModel();
+    publish(std::make_shared<const CatalogSnapshot>(books));
     endResetModel();
     emit countChanged();
+    emit catalogPublished();
 }
 
 void LibraryModel::addBook(const QString &title, const QString &author, const QString &status, const QString &contactName, const QString &contactNumber)
 {
     QSqlQuery query;
-    query.prepare("INSERT INTO books (title, author, status, contact_name, contact_number) VALUES (:title, :author, :status, :contactName, :contactNumber)");
+    query.prepare("INSERT INTO books (title, author, status, contact_name, contact_number) VALUES (:title, :author, :status, :contactName, :contactNumber) RETURNING id");
     query.bindValue(":title", title);
     query.bindValue(":author", author);
     query.bindValue(":status", status);
     query.bindValue(":contactName", contactName);
     query.bindValue(":contactNumber", contactNumber);
 
-    if (query.exec()) {
-        refresh();
+    if (query.exec() && query.next()) {
+        // Newest first, so the new book becomes row 0
+        Book book;
+        book.id = query.value(0).toInt();
+        book.title = title;
+        book.author = author;
+        book.status = internStatus(status);
+        book.contactName = contactName;
+        book.contactNumber = contactNumber;
+
+        beginInsertRows(QModelIndex(), 0, 0);
+        publish(m_books->inserted(0, book));
+        endInsertRows();
+        emit countChanged();
+        emit catalogPublished();
     } else {
         qCritical() << "Failed to add book:" << query.lastError().text();
     }
@@ -102,44 +107,135 @@ void LibraryModel::updateBook(int id, const QString &title, const QString &autho
     query.bindValue(":contactNumber", contactNumber);
     query.bindValue(":id", id);
 
-    if (query.exec()) {
-        refresh();
-    } else {
+    if (!query.exec()) {
         qCritical() << "Failed to update book:" << query.lastError().text();
+        return;
+    }
+
+    const int row = m_books->indexOfId(id);
+    if (row < 0) {
+        refresh();
+        return;
     }
+
+    Book book;
+    book.id = id;
+    book.title = title;
+    book.author = author;
+    book.status = internStatus(status);
+    book.contactName = contactName;
+    book.contactNumber = contactNumber;
+
+    // Only the chunk holding this row is copied
+    publish(m_books->replaced(row, book));
+    emit dataChanged(this->index(row), this->index(row));
+    emit countChanged();
+    emit catalogPublished();
 }
 
 void LibraryModel::removeBook(int index)
 {
-    if (index < 0 || index >= m_books.count()) return;
+    if (index < 0 || index >= m_books->count()) return;
 
-    int id = m_books[index].id;
+    int id = m_books->at(index).id;
     QSqlQuery query;
     query.prepare("DELETE FROM books WHERE id = :id");
     query.bindValue(":id", id);
 
     if (query.exec()) {
-        refresh();
+        beginRemoveRows(QModelIndex(), index, index);
+        publish(m_books->removed(index));
+        endRemoveRows();
+        emit countChanged();
+        emit catalogPublished();
     } else {
         qCritical() << "Failed to delete book:" << query.lastError().text();
     }
 }
 
+// Folds a duplicate record into the one being kept, then deletes the duplicate.
+// The loan state travels as a unit: if the kept record is on the shelf and the
+// duplicate is LOANED/BORROWED, the duplicate's status and contact details win;
+// otherwise the kept record's status stays and only its empty contact fields
+// are filled in. Records that are LOANED and BORROWED respectively conflict and
+// are not merged, and neither are two loans to (or from) different people:
+// those are two physical copies. Nothing is deleted unless the kept record
+// was updated.
+bool LibraryModel::mergeBooks(int keepId, int duplicateId)
+{
+    if (keepId == duplicateId) return false;
+
+    QSqlDatabase db = QSqlDatabase::database();
+    if (!db.transaction()) {
+        qCritical() << "Failed to start merge transaction:" << db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query;
+    query.prepare("UPDATE books AS k SET "
+                  "status = CASE WHEN k.status = 'SHELF' THEN d.status ELSE k.status END, "
+                  "contact_name = CASE WHEN k.status = 'SHELF' AND d.status <> 'SHELF' THEN d.contact_name "
+                  "ELSE COALESCE(NULLIF(k.contact_name, ''), d.contact_name) END, "
+                  "contact_number = CASE WHEN k.status = 'SHELF' AND d.status <> 'SHELF' THEN d.contact_number "
+                  "ELSE COALESCE(NULLIF(k.contact_number, ''), d.contact_number) END "
+                  "FROM books AS d WHERE k.id = :keepId AND d.id = :duplicateId "
+                  "AND (k.status = d.status OR k.status = 'SHELF' OR d.status = 'SHELF') "
+                  "AND NOT (k.status <> 'SHELF' AND d.status <> 'SHELF' AND ("
+                  "(COALESCE(k.contact_name, '') <> '' AND COALESCE(d.contact_name, '') <> '' "
+                  "AND k.contact_name <> d.contact_name) OR "
+                  "(COALESCE(k.contact_number, '') <> '' AND COALESCE(d.contact_number, '') <> '' "
+                  "AND k.contact_number <> d.contact_number)))");
+    query.bindValue(":keepId", keepId);
+    query.bindValue(":duplicateId", duplicateId);
+
+    if (!query.exec()) {
+        qCritical() << "Failed to merge book:" << query.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    // Either record is gone (stale report, another client) or the loans conflict
+    if (query.numRowsAffected() != 1) {
+        qWarning() << "Not merging book" << duplicateId << "into" << keepId
+                   << "- a record is missing or their loans conflict";
+        db.rollback();
+        return false;
+    }
+
+    query.prepare("DELETE FROM books WHERE id = :id");
+    query.bindValue(":id", duplicateId);
+
+    if (!query.exec()) {
+        qCritical() << "Failed to remove merged book:" << query.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    if (!db.commit()) {
+        qCritical() << "Failed to commit merge:" << db.lastError().text();
+        db.rollback();
+        return false;
+    }
+
+    refresh();
+    return true;
+}
+
 int LibraryModel::getShelfCount() const
 {
     int count = 0;
-    for (const Book &book : m_books) {
+    m_books->forEach([&count](const Book &book) {
         if (book.status == "SHELF") count++;
-    }
+    });
     return count;
 }
 
 int LibraryModel::getLoanedCount() const
 {
     int count = 0;
-    for (const Book &book : m_books) {
+    m_books->forEach([&count](const Book &book) {
         if (book.status == "LOANED" || book.status == "BORROWED") count++;
-    }
+    });
     return count;
 }
 
@@ -2,17 +2,9 @@
 #define LIBRARYMODEL_H
 
 #include <QAbstractListModel>
-#include <QList>
 #include <QVariant>
-
-struct Book {
-    int id;
-    QString title;
-    QString author;
-    QString status;
-    QString contactName;
-    QString contactNumber;
-};
+#include "BookRoles.h"
+#include "Catalog.h"
 
 class LibraryModel : public QAbstractListModel
 {
@@ -22,33 +14,47 @@ class LibraryModel : public QAbstractListModel
     Q_PROPERTY(int loanedCount READ getLoanedCount NOTIFY countChanged)
 public:
     enum BookRoles {
-        IdRole = Qt::UserRole + 1,
-        TitleRole,
-        AuthorRole,
-        StatusRole,
-        ContactNameRole,
-        ContactNumberRole
+        IdRole = BookIdRole,
+        TitleRole = BookTitleRole,
+        AuthorRole = BookAuthorRole,
+        StatusRole = BookStatusRole,
+        ContactNameRole = BookContactNameRole,
+        ContactNumberRole = BookContactNumberRole
     };
 
     explicit LibraryModel(QObject *parent = nullptr);
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    void multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const override;
     QHash<int, QByteArray> roleNames() const override;
 
     Q_INVOKABLE void refresh();
     Q_INVOKABLE void addBook(const QString &title, const QString &author, const QString &status, const QString &contactName, const QString &contactNumber);
     Q_INVOKABLE void updateBook(int id, const QString &title, const QString &author, const QString &status, const QString &contactName, const QString &contactNumber);
     Q_INVOKABLE void removeBook(int index);
+    Q_INVOKABLE bool mergeBooks(int keepId, int duplicateId);
     
+    // Current catalog version; safe to call and read from any thread
+    CatalogSnapshotPtr snapshot() const { return m_catalog.snapshot(); }
     int getShelfCount() const;
     int getLoanedCount() const;
 
 signals:
     void countChanged();
+    // Emitted after every new catalog version, once views have been told
+    // about the change; snapshot() already returns it
+    void catalogPublished();
 
 private:
-    QList<Book> m_books;
+    // Publishes a new version; must be called between the matching
+    // begin/end model notifications so views see a consistent change.
+    // Callers emit catalogPublished() after the end notification, so
+    // listeners never run while the model is mid-change.
+    void publish(CatalogSnapshotPtr snapshot);
+
+    Catalog m_catalog;
+    CatalogSnapshotPtr m_books;  // Version the GUI thread is showing
 };
 
 #endif // LIBRARYMODEL_H
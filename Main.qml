@@ -17,6 +17,20 @@ Window {
         }
     }
 
+    // Dialog for reviewing and merging duplicate books
+    DuplicateReportDialog {
+        id: duplicateDialog
+        
+        onMergeRequested: function(keepId, duplicateIds) {
+            // Stop at the first refusal (record gone or conflicting loan status)
+            for (let i = 0; i < duplicateIds.length; i++) {
+                if (!libraryModel.mergeBooks(keepId, duplicateIds[i]))
+                    break
+            }
+            duplicateDialog.report = duplicateDetector.scanCatalog()
+        }
+    }
+
     ColumnLayout {
         anchors.fill: parent
         spacing: 0
@@ -69,6 +83,11 @@ Window {
                 onDeleteBookRequested: function(index) {
                     libraryModel.removeBook(index)
                 }
+                
+                onFindDuplicatesRequested: {
+                    duplicateDialog.report = duplicateDetector.scanCatalog()
+                    duplicateDialog.open()
+                }
             }
 
             // Page 2: Add Book
@@ -0,0 +1,283 @@
+// SearchIndex.cpp
+// ============================================================================
+// Implementation of the immutable search indexes and the query planner
+// ============================================================================
+
+#include "SearchIndex.h"
+#include <QDebug>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+namespace {
+
+// Trigram length for the title/author text indexes
+constexpr int kTrigramSize = 3;
+
+using TrigramIndex = QHash<QString, QList<int>>;
+
+// containsFolded: Substring test under the same case folding as the index
+// keys and the parsed term values (SearchQuery::parse), so every row the
+// exact test accepts is also a trigram candidate ("ΤΕΛΟΣ" ~ "τελος")
+bool containsFolded(const QString &text, const QString &foldedValue)
+{
+    return text.toCaseFolded().contains(foldedValue);
+}
+
+// addTrigrams: Post a row under every distinct trigram of the text
+// Rows are added in increasing order, so each posting list stays sorted
+void addTrigrams(TrigramIndex &index, const QString &text, int row)
+{
+    for (int i = 0; i + kTrigramSize <= text.size(); ++i) {
+        QList<int> &rows = index[text.mid(i, kTrigramSize)];
+        if (rows.isEmpty() || rows.last() != row)
+            rows.append(row);
+    }
+}
+
+// trigramEstimate: Size of the shortest posting list among the value's
+// trigrams (0 if one is missing); values shorter than a trigram can't use
+// the index and estimate the whole catalog
+int trigramEstimate(const TrigramIndex &index, const QString &value, int count)
+{
+    if (value.size() < kTrigramSize)
+        return count;
+
+    int estimate = count;
+    for (int i = 0; i + kTrigramSize <= value.size(); ++i) {
+        const auto it = index.constFind(value.mid(i, kTrigramSize));
+        if (it == index.constEnd())
+            return 0;
+        estimate = qMin(estimate, int(it->count()));
+    }
+    return estimate;
+}
+
+// trigramCandidates: Rows containing every trigram of the value
+// Posting lists are intersected shortest first
+QList<int> trigramCandidates(const TrigramIndex &index, const QString &value)
+{
+    QList<const QList<int> *> postings;
+    for (int i = 0; i + kTrigramSize <= value.size(); ++i) {
+        const auto it = index.constFind(value.mid(i, kTrigramSize));
+        if (it == index.constEnd())
+            return QList<int>();
+        postings.append(&*it);
+    }
+
+    std::sort(postings.begin(), postings.end(), [](const QList<int> *a, const QList<int> *b) {
+        return a->count() < b->count();
+    });
+
+    QList<int> rows = *postings.first();
+    for (int i = 1; i < postings.count() && !rows.isEmpty(); ++i) {
+        QList<int> narrowed;
+        std::set_intersection(rows.begin(), rows.end(),
+                              postings[i]->begin(), postings[i]->end(),
+                              std::back_inserter(narrowed));
+        rows = narrowed;
+    }
+    return rows;
+}
+
+} // namespace
+
+// ============================================================================
+// QUERY PLANNER
+// ============================================================================
+
+// Constructor: One pass over the snapshot
+// Status bitmaps answer status:X without touching the books; trigram
+// postings narrow title/author substring terms to a few candidate rows
+SearchIndex::SearchIndex(CatalogSnapshotPtr books)
+    : m_books(std::move(books))
+{
+    const int count = m_books->count();
+    int row = 0;
+    m_books->forEach([&](const Book &book) {
+        QBitArray &bits = m_statusIndex[book.status];
+        if (bits.size() != count)
+            bits.resize(count);
+        bits.setBit(row);
+
+        addTrigrams(m_titleTrigrams, book.title.toCaseFolded(), row);
+        addTrigrams(m_authorTrigrams, book.author.toCaseFolded(), row);
+        row++;
+    });
+}
+
+// estimateMatches: Cardinality estimate used to rank terms
+// Example: in a 5000-book library "status:LOANED" may estimate 40 while
+// "dark" estimates 300, so the status bitmap drives the search
+int SearchIndex::estimateMatches(const SearchTerm &term) const
+{
+    const int count = m_books->count();
+
+    switch (term.field) {
+    case SearchTerm::Status:
+        return int(m_statusIndex.value(term.value).count(true));
+    case SearchTerm::Title:
+        return trigramEstimate(m_titleTrigrams, term.value, count);
+    case SearchTerm::Author:
+        return trigramEstimate(m_authorTrigrams, term.value, count);
+    case SearchTerm::Any:
+        return qMin(count, trigramEstimate(m_titleTrigrams, term.value, count)
+                               + trigramEstimate(m_authorTrigrams, term.value, count));
+    case SearchTerm::Contact:
+        break;  // Not indexed
+    }
+    return count;
+}
+
+// candidateRows: Use the index that belongs to the term, else scan everything
+QList<int> SearchIndex::candidateRows(const SearchTerm &term) const
+{
+    const int count = m_books->count();
+
+    switch (term.field) {
+    case SearchTerm::Status: {
+        const QBitArray bits = m_statusIndex.value(term.value);
+        QList<int> rows;
+        for (int row = 0; row < bits.size(); ++row) {
+            if (bits.testBit(row))
+                rows.append(row);
+        }
+        return rows;
+    }
+    case SearchTerm::Title:
+        if (term.value.size() >= kTrigramSize)
+            return trigramCandidates(m_titleTrigrams, term.value);
+        break;
+    case SearchTerm::Author:
+        if (term.value.size() >= kTrigramSize)
+            return trigramCandidates(m_authorTrigrams, term.value);
+        break;
+    case SearchTerm::Any:
+        if (term.value.size() >= kTrigramSize) {
+            const QList<int> titleRows = trigramCandidates(m_titleTrigrams, term.value);
+            const QList<int> authorRows = trigramCandidates(m_authorTrigrams, term.value);
+            QList<int> rows;
+            std::set_union(titleRows.begin(), titleRows.end(),
+                           authorRows.begin(), authorRows.end(),
+                           std::back_inserter(rows));
+            return rows;
+        }
+        break;
+    case SearchTerm::Contact:
+        break;
+    }
+
+    // Full scan
+    QList<int> rows(count);
+    std::iota(rows.begin(), rows.end(), 0);
+    return rows;
+}
+
+// matches: Case-folded substring match, exact match for status
+// Example: "8" matches "From a Buick 8"
+bool SearchIndex::matches(const SearchTerm &term, int row) const
+{
+    const Book &book = m_books->at(row);
+
+    switch (term.field) {
+    case SearchTerm::Title:
+        return containsFolded(book.title, term.value);
+    case SearchTerm::Author:
+        return containsFolded(book.author, term.value);
+    case SearchTerm::Status:
+        return book.status == term.value;
+    case SearchTerm::Contact:
+        return containsFolded(book.contactName, term.value)
+               || containsFolded(book.contactNumber, term.value);
+    case SearchTerm::Any:
+        return containsFolded(book.title, term.value)
+               || containsFolded(book.author, term.value);
+    }
+    return false;
+}
+
+// plan: Returns term indexes in evaluation order
+// Terms are ranked by the fraction of books expected to pass them: a
+// positive term passes its matches, a negated term passes everything else.
+// A positive term always comes first because only it can drive the search.
+QList<int> SearchIndex::plan(const SearchQuery &query) const
+{
+    const QList<SearchTerm> &terms = query.terms();
+    const double count = qMax(1, int(m_books->count()));
+
+    QList<QPair<double, int>> ranked;
+    for (int i = 0; i < terms.count(); ++i) {
+        const double matchFraction = estimateMatches(terms[i]) / count;
+        ranked.append(qMakePair(terms[i].negated ? 1.0 - matchFraction : matchFraction, i));
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const auto &a, const auto &b) {
+        return a.first < b.first;
+    });
+
+    QList<int> order;
+    for (const auto &entry : ranked)
+        order.append(entry.second);
+
+    // Move the most selective positive term to the front as the driver
+    const auto driver = std::find_if(order.begin(), order.end(), [&terms](int i) {
+        return !terms[i].negated;
+    });
+    if (driver != order.end())
+        std::rotate(order.begin(), driver, driver + 1);
+
+    return order;
+}
+
+// execute: Drive from the first term's index, then check the remaining
+// terms per candidate, stopping at the first one that fails
+QList<Book> SearchIndex::execute(const SearchQuery &query) const
+{
+    QList<Book> results;
+
+    // Return early if query is empty
+    if (query.isEmpty()) {
+        qDebug() << "Search: empty query";
+        return results;
+    }
+
+    const QList<SearchTerm> &terms = query.terms();
+    QList<int> order = plan(query);
+
+    QList<int> candidates;
+    const SearchTerm &first = terms[order.first()];
+    if (first.negated) {
+        // Only exclusions: nothing to drive from, scan the whole catalog
+        candidates.resize(m_books->count());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    } else {
+        // Short-circuit: the driver alone proves there can be no results
+        if (estimateMatches(first) == 0) {
+            qDebug() << "Search plan: no candidates for" << first.value;
+            return results;
+        }
+        candidates = candidateRows(first);
+
+        // Bitmap rows are exact; trigram and scan rows still get verified
+        if (first.field == SearchTerm::Status)
+            order.removeFirst();
+    }
+
+    qDebug() << "Search plan:" << terms.count() << "terms," << candidates.count()
+             << "candidates of" << m_books->count() << "books";
+
+    for (int row : candidates) {
+        bool accepted = true;
+        for (int i : order) {
+            if (matches(terms[i], row) == terms[i].negated) {
+                accepted = false;
+                break;
+            }
+        }
+        if (accepted)
+            results.append(m_books->at(row));
+    }
+    return results;
+}
@@ -0,0 +1,72 @@
+// SearchIndex.h
+// ============================================================================
+// Purpose: Immutable search indexes over one catalog version
+// Responsibilities:
+//   - Holds the catalog snapshot it was built from, so row numbers in the
+//     indexes always refer to the books they were computed for
+//   - Maintains status bitmaps and title/author trigram indexes
+//   - Plans structured queries (see SearchQuery.h) so the most selective
+//     term drives the search, and executes them
+// Threading: never modified after construction. SearchModel builds a new
+//            index for every catalog version and publishes it alongside the
+//            snapshot, so any thread holding an index can query it.
+// ============================================================================
+
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QBitArray>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <memory>
+#include "Catalog.h"
+#include "SearchQuery.h"
+
+class SearchIndex;
+using SearchIndexPtr = std::shared_ptr<const SearchIndex>;
+
+class SearchIndex
+{
+public:
+    // Constructor: Index every book of the snapshot (one pass)
+    explicit SearchIndex(CatalogSnapshotPtr books);
+
+    // books: Catalog version this index was built from
+    const CatalogSnapshotPtr &books() const { return m_books; }
+
+    // estimateMatches: Upper bound on the number of books matching a term,
+    // read from the indexes (the whole catalog when no index applies)
+    int estimateMatches(const SearchTerm &term) const;
+
+    // candidateRows: Rows that may match a positive term, from its index
+    // Trigram candidates still need to be verified with matches()
+    QList<int> candidateRows(const SearchTerm &term) const;
+
+    // matches: Exact test of one (non-negated) term against one book
+    bool matches(const SearchTerm &term, int row) const;
+
+    // plan: Order the query's terms for evaluation
+    // The first positive term is the most selective and drives the search;
+    // the rest follow by how many books they are expected to reject
+    QList<int> plan(const SearchQuery &query) const;
+
+    // execute: Run a planned query; books come back in catalog order
+    // An empty query matches nothing
+    QList<Book> execute(const SearchQuery &query) const;
+
+private:
+    // m_books: The indexed version; row numbers below refer to it and
+    // every row list is sorted ascending
+    CatalogSnapshotPtr m_books;
+
+    // m_statusIndex: One bitmap per status value (bit set = book has status)
+    QHash<QString, QBitArray> m_statusIndex;
+
+    // m_titleTrigrams / m_authorTrigrams: Case-folded three-character
+    // substring -> rows whose title/author contains it
+    QHash<QString, QList<int>> m_titleTrigrams;
+    QHash<QString, QList<int>> m_authorTrigrams;
+};
+
+#endif // SEARCHINDEX_H
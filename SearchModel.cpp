@@ -5,6 +5,7 @@
 
 #include "SearchModel.h"
 #include "DatabaseManager.h"
+#include "LibraryModel.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -12,12 +13,21 @@
 // ============================================================================
 // CONSTRUCTOR
 // ============================================================================
-// Initializes the search model and loads all books from the database
-SearchModel::SearchModel(QObject *parent)
+// Searches the library's catalog instead of keeping a copy of the books
+SearchModel::SearchModel(LibraryModel *library, QObject *parent)
     : QAbstractListModel(parent)
+    , m_library(library)
 {
-    // Load all books from database into cache for fast searching
-    loadAllBooks();
+    // Every add, update, delete or reload publishes a new version
+    connect(m_library, &LibraryModel::catalogPublished, this, &SearchModel::onCatalogPublished);
+
+    m_rebuildTimer.setSingleShot(true);
+    m_rebuildTimer.setInterval(0);
+    connect(&m_rebuildTimer, &QTimer::timeout, this, &SearchModel::rebuild);
+
+    // Index the version that is current now; results start out showing all of it
+    m_index.store(std::make_shared<const SearchIndex>(m_library->snapshot()));
+    m_results = m_index.load()->books();
 }
 
 // ============================================================================
@@ -33,7 +43,7 @@ int SearchModel::rowCount(const QModelIndex &parent) const
         return 0;
     
     // Return the count of results matching current search criteria
-    return m_results.count();
+    return m_results->count();
 }
 
 // data: Retrieve data for a specific book and role (property)
@@ -42,43 +52,35 @@ int SearchModel::rowCount(const QModelIndex &parent) const
 QVariant SearchModel::data(const QModelIndex &index, int role) const
 {
     // Validate the index is within bounds
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_results.count())
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_results->count())
         return QVariant();
 
-    // Get the book at this index
-    const BookResult &book = m_results[index.row()];
-
-    // Return the appropriate property based on the role
-    switch (role) {
-    case IdRole:
-        return book.id;
-    case TitleRole:
-        return book.title;
-    case AuthorRole:
-        return book.author;
-    case StatusRole:
-        return book.status;
-    case ContactNameRole:
-        return book.contactName;
-    case ContactNumberRole:
-        return book.contactNumber;
-    default:
-        return QVariant();  // Unknown role
+    // Return the appropriate property of the book at this index
+    return bookData(m_results->at(index.row()), role);
+}
+
+// multiData: Retrieve several roles of one book at once
+// Each grid delegate reads six roles; answering them together costs one
+// bounds check and one row lookup instead of six separate data() calls
+void SearchModel::multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const
+{
+    // Out-of-range rows yield empty values for every requested role
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_results->count()) {
+        for (QModelRoleData &roleData : roleDataSpan)
+            roleData.clearData();
+        return;
     }
+
+    const Book &book = m_results->at(index.row());
+    for (QModelRoleData &roleData : roleDataSpan)
+        roleData.setData(bookData(book, roleData.role()));
 }
 
 // roleNames: Map role enums to property names accessible from QML
 // This allows QML to access properties like: model.title, model.author, etc.
 QHash<int, QByteArray> SearchModel::roleNames() const
 {
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";                           // Book ID
-    roles[TitleRole] = "title";                     // Book title
-    roles[AuthorRole] = "author";                   // Author name
-    roles[StatusRole] = "status";                   // Book status
-    roles[ContactNameRole] = "contactName";         // Contact person
-    roles[ContactNumberRole] = "contactNumber";     // Contact phone
-    return roles;
+    return bookRoleNames();
 }
 
 // ============================================================================
@@ -89,33 +91,51 @@ QHash<int, QByteArray> SearchModel::roleNames() const
 // This is the main entry point for searching books
 void SearchModel::performSearch(const QString &query, const QString &searchType)
 {
-    // Update the current search query for display purposes
+    // Remember the search so it can be re-run on the next catalog version
     m_currentSearch = query;
+    m_searchType = searchType;
+    m_searchFromDatabase = false;
+    m_searchActive = true;
+    updateIndex();
 
-    // Perform the appropriate type of search based on user selection
-    if (searchType == "title") {
-        // Search by title only
-        performTitleSearch(query);
-    } 
-    else if (searchType == "author") {
-        // Search by author only
-        performAuthorSearch(query);
-    } 
-    else if (searchType == "status") {
-        // Filter by status (exact match)
-        performStatusSearch(query);
-    } 
-    else {
-        // Default: search both title and author
-        performFullSearch(query);
-    }
+    // Evaluate it against the indexed catalog, most selective term first
+    beginResetModel();
+    runSearch();
+    endResetModel();
 
     // Notify QML that results have changed
     emit resultsChanged();
     emit searchChanged();
 
     // Log search results for debugging
-    qDebug() << "Search completed:" << query << "Results:" << m_results.count();
+    qDebug() << "Search completed:" << query << "Results:" << m_results->count();
+}
+
+// performDatabaseSearch: Push the parsed query down to PostgreSQL
+// The in-memory planner is not used here; PostgreSQL plans the WHERE clause
+// itself from its own statistics
+void SearchModel::performDatabaseSearch(const QString &query, const QString &searchType)
+{
+    // Without a connection the in-memory catalog is the only source of books
+    if (!QSqlDatabase::database().isOpen()) {
+        performSearch(query, searchType);
+        return;
+    }
+
+    m_currentSearch = query;
+    m_searchType = searchType;
+    m_searchFromDatabase = true;
+    m_searchActive = true;
+    updateIndex();
+
+    beginResetModel();
+    runSearch();
+    endResetModel();
+
+    emit resultsChanged();
+    emit searchChanged();
+
+    qDebug() << "Database search completed:" << query << "Results:" << m_results->count();
 }
 
 // clearSearch: Reset search and show all books
@@ -123,163 +143,93 @@ void SearchModel::clearSearch()
 {
     // Reset search state
     m_currentSearch = "";
-    
-    // Reset results to show all books
+    m_searchActive = false;
+    updateIndex();
+
+    // Reset results to show all books (shares the indexed version, no copy)
     beginResetModel();
-    m_results = m_allBooks;
+    m_results = m_index.load()->books();
     endResetModel();
 
     // Notify QML of state change
     emit resultsChanged();
     emit searchChanged();
 
-    qDebug() << "Search cleared. Showing all" << m_results.count() << "books";
+    qDebug() << "Search cleared. Showing all" << m_results->count() << "books";
 }
 
 // ============================================================================
 // PRIVATE SEARCH IMPLEMENTATION METHODS
 // ============================================================================
 
-// loadAllBooks: Load all books from database into memory
-// This is called once during initialization for fast searching
-void SearchModel::loadAllBooks()
+// onCatalogPublished: Runs after the library's views were notified; the
+// rebuild waits for the event loop so a burst of edits is indexed (and a
+// database search re-run) only once
+void SearchModel::onCatalogPublished()
 {
-    // Clear any existing data
-    m_results.clear();
-    m_allBooks.clear();
-
-    // Query all books from the database ordered by ID (newest first)
-    QSqlQuery query("SELECT id, title, author, status, contact_name, contact_number FROM books ORDER BY id DESC");
-
-    // Iterate through each row returned by the query
-    while (query.next()) {
-        // Create a new book result object
-        BookResult book;
-        book.id = query.value(0).toInt();                   // Get ID
-        book.title = query.value(1).toString();             // Get title
-        book.author = query.value(2).toString();            // Get author
-        book.status = query.value(3).toString();            // Get status
-        book.contactName = query.value(4).toString();       // Get contact name
-        book.contactNumber = query.value(5).toString();     // Get contact number
-
-        // Add to both cache lists
-        m_allBooks.append(book);
-        m_results.append(book);
-    }
-
-    // Check for database errors
-    if (query.lastError().isValid()) {
-        qCritical() << "Failed to load books for search:" << query.lastError().text();
-    }
-
-    qDebug() << "Loaded" << m_allBooks.count() << "books for searching";
+    m_rebuildTimer.start();
 }
 
-// performTitleSearch: Search books by title (case-insensitive partial match)
-// Example: "the fix" finds "The Fix" and "The Five"
-// Also searches for numbers and special characters like "8" in "From a Buick 8"
-void SearchModel::performTitleSearch(const QString &query)
+// rebuild: Refresh results from the library's current version
+void SearchModel::rebuild()
 {
-    // Clear previous results
-    m_results.clear();
+    updateIndex();
 
-    // Convert search query to lowercase for case-insensitive comparison
-    QString lowerQuery = query.toLower().trimmed();
-    
-    // Return early if query is empty
-    if (lowerQuery.isEmpty()) {
-        qDebug() << "Title search: empty query";
-        return;
-    }
-
-    // Iterate through all books in cache
-    for (const BookResult &book : m_allBooks) {
-        QString lowerTitle = book.title.toLower();
-        
-        // Primary match: exact substring contains (catches "Buick" and "8")
-        if (lowerTitle.contains(lowerQuery)) {
-            m_results.append(book);  // Add matching book to results
-            continue;
-        }
-    }
+    beginResetModel();
+    if (m_searchActive)
+        runSearch();
+    else
+        m_results = m_index.load()->books();
+    endResetModel();
 
-    qDebug() << "Title search for" << query << "found" << m_results.count() << "matches";
+    emit resultsChanged();
 }
 
-// performAuthorSearch: Search books by author (case-insensitive partial match)
-// Example: "smith" finds "John Smith" and "Adam Smith"
-void SearchModel::performAuthorSearch(const QString &query)
+// updateIndex: Build the index for the library's current version before
+// publishing it, so readers always get an index matching its snapshot
+void SearchModel::updateIndex()
 {
-    // Clear previous results
-    m_results.clear();
+    m_rebuildTimer.stop();
 
-    // Convert search query to lowercase for case-insensitive comparison
-    QString lowerQuery = query.toLower().trimmed();
-    
-    // Return early if query is empty
-    if (lowerQuery.isEmpty()) {
-        qDebug() << "Author search: empty query";
-        return;
-    }
-
-    // Iterate through all books in cache
-    for (const BookResult &book : m_allBooks) {
-        // Check if author name contains the search query (case-insensitive)
-        if (book.author.toLower().contains(lowerQuery)) {
-            m_results.append(book);  // Add matching book to results
-        }
-    }
-
-    qDebug() << "Author search for" << query << "found" << m_results.count() << "matches";
+    const CatalogSnapshotPtr snapshot = m_library->snapshot();
+    if (m_index.load()->books() != snapshot)
+        m_index.store(std::make_shared<const SearchIndex>(snapshot));
 }
 
-// performStatusSearch: Filter books by exact status value
-// Valid statuses: "SHELF", "LOANED", "BORROWED"
-void SearchModel::performStatusSearch(const QString &status)
+// runSearch: Parse the current search; the filter type only sets the field
+// for bare terms
+void SearchModel::runSearch()
 {
-    // Clear previous results
-    m_results.clear();
-
-    // Iterate through all books in cache
-    for (const BookResult &book : m_allBooks) {
-        // Check if book status matches exactly (case-sensitive)
-        if (book.status == status) {
-            m_results.append(book);  // Add matching book to results
-        }
-    }
+    const SearchQuery parsed = SearchQuery::parse(m_currentSearch, SearchQuery::fieldFromSearchType(m_searchType));
 
-    qDebug() << "Status search for" << status << "found" << m_results.count() << "matches";
+    const QList<Book> results = m_searchFromDatabase ? databaseResults(parsed)
+                                                     : m_index.load()->execute(parsed);
+    m_results = std::make_shared<const CatalogSnapshot>(results);
 }
 
-// performFullSearch: Search both title and author fields
-// Example: "tolkien" finds books with "tolkien" in title OR author
-// This is more comprehensive and catches partial matches in either field
-void SearchModel::performFullSearch(const QString &query)
+// databaseResults: Run the query as a WHERE clause
+QList<Book> SearchModel::databaseResults(const SearchQuery &query) const
 {
-    // Clear previous results
-    m_results.clear();
-
-    // Convert search query to lowercase for case-insensitive comparison
-    QString lowerQuery = query.toLower().trimmed();
-    
-    // Return early if query is empty
-    if (lowerQuery.isEmpty()) {
-        qDebug() << "Full search: empty query";
-        return;
+    QList<Book> results;
+
+    // An empty query matches nothing, same as the in-memory search
+    if (query.isEmpty())
+        return results;
+
+    QVariantList bindValues;
+    const QString where = query.toSqlWhere(bindValues);
+
+    QSqlQuery sql;
+    sql.prepare("SELECT id, title, author, status, contact_name, contact_number FROM books WHERE "
+                + where + " ORDER BY id DESC");
+    for (const QVariant &value : bindValues)
+        sql.addBindValue(value);
+
+    if (sql.exec()) {
+        while (sql.next())
+            results.append(DatabaseManager::bookFromQuery(sql));
+    } else {
+        qCritical() << "Database search failed:" << sql.lastError().text();
     }
-
-    // Iterate through all books in cache
-    for (const BookResult &book : m_allBooks) {
-        QString lowerTitle = book.title.toLower();
-        QString lowerAuthor = book.author.toLower();
-        
-        // Check if EITHER title OR author contains the search query (case-insensitive)
-        // This is sensitive enough to catch "Buick" in "From a Buick 8"
-        // and also catches numbers like "8"
-        if (lowerTitle.contains(lowerQuery) || lowerAuthor.contains(lowerQuery)) {
-            m_results.append(book);  // Add matching book to results
-        }
-    }
-
-    qDebug() << "Full search for" << query << "found" << m_results.count() << "matches";
+    return results;
 }
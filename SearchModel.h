@@ -2,7 +2,12 @@
 // ============================================================================
 // Purpose: Provides search and filtering capabilities for the book library
 // Responsibilities:
-//   - Filters books by title, author, or status
+//   - Filters books by title, author, status, or contact
+//   - Parses structured queries (see SearchQuery.h) and runs them against
+//     the LibraryModel catalog through a SearchIndex (see SearchIndex.h)
+//   - Rebuilds the index after the library publishes a new version and
+//     re-runs the current search, once per event loop pass however many
+//     versions were published in it
 //   - Maintains a list of search results
 //   - Emits signals when search results change
 //   - Supports real-time search as user types
@@ -12,18 +17,14 @@
 #define SEARCHMODEL_H
 
 #include <QAbstractListModel>
-#include <QList>
 #include <QString>
+#include <QTimer>
+#include "BookRoles.h"
+#include "Catalog.h"
+#include "SearchIndex.h"
+#include "SearchQuery.h"
 
-// Book struct - represents a single book record
-struct BookResult {
-    int id;                    // Unique identifier for the book
-    QString title;             // Title of the book
-    QString author;            // Author name
-    QString status;            // Book status: SHELF, LOANED, BORROWED
-    QString contactName;       // Contact person if book is loaned/borrowed
-    QString contactNumber;     // Contact phone number
-};
+class LibraryModel;
 
 // SearchModel class - manages search results and filtering
 class SearchModel : public QAbstractListModel
@@ -37,16 +38,17 @@ class SearchModel : public QAbstractListModel
 public:
     // Define roles for accessing book properties from the model
     enum BookRoles {
-        IdRole = Qt::UserRole + 1,
-        TitleRole,
-        AuthorRole,
-        StatusRole,
-        ContactNameRole,
-        ContactNumberRole
+        IdRole = BookIdRole,
+        TitleRole = BookTitleRole,
+        AuthorRole = BookAuthorRole,
+        StatusRole = BookStatusRole,
+        ContactNameRole = BookContactNameRole,
+        ContactNumberRole = BookContactNumberRole
     };
 
-    // Constructor: Initialize the search model
-    explicit SearchModel(QObject *parent = nullptr);
+    // Constructor: Index the library's current catalog version and follow
+    // every version it publishes afterwards
+    explicit SearchModel(LibraryModel *library, QObject *parent = nullptr);
 
     // ========== Qt Model Interface Methods ==========
     // These methods are required for QAbstractListModel to function
@@ -57,18 +59,28 @@ public:
     // data: Retrieves data for a specific book and role
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
 
+    // multiData: Fills every requested role of one row in a single call
+    // (QML delegates request all of their roles together)
+    void multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const override;
+
     // roleNames: Maps role enums to property names for QML access
     QHash<int, QByteArray> roleNames() const override;
 
     // ========== Public Methods ==========
     
-    // performSearch: Execute a search query on all books
+    // performSearch: Execute a search query on the in-memory catalog
     // Parameters:
-    //   - query: The search term (title, author, or exact status)
-    //   - searchType: "all" (title+author), "title", "author", or "status"
+    //   - query: Structured query, e.g. author:king status:LOANED "dark tower"
+    //   - searchType: Field for terms without a prefix:
+    //     "all" (title+author), "title", "author", or "status"
     // Emits: resultsChanged signal when search completes
     Q_INVOKABLE void performSearch(const QString &query, const QString &searchType = "all");
 
+    // performDatabaseSearch: Execute the same query as a SQL WHERE clause
+    // against the database, so results also include changes made by other
+    // clients. Falls back to performSearch without a connection.
+    Q_INVOKABLE void performDatabaseSearch(const QString &query, const QString &searchType = "all");
+
     // clearSearch: Reset search results and show all books
     // Emits: resultsChanged and searchChanged signals
     Q_INVOKABLE void clearSearch();
@@ -77,7 +89,13 @@ public:
     QString getCurrentSearch() const { return m_currentSearch; }
 
     // getResultCount: Get the number of search results
-    int getResultCount() const { return m_results.count(); }
+    int getResultCount() const { return m_results->count(); }
+
+    // searchIndex: Index over the catalog version last indexed
+    // Safe to call and query from any thread (e.g. a background search);
+    // the index and the snapshot inside it never change once published.
+    // Until the pending rebuild runs it may be one version behind the library.
+    SearchIndexPtr searchIndex() const { return m_index.load(); }
 
     // ========== Signals ==========
     // These signals notify QML when the search state changes
@@ -89,35 +107,53 @@ signals:
     // searchChanged: Emitted when the search query changes
     void searchChanged();
 
+private slots:
+    // onCatalogPublished: Schedule a rebuild; edits made in the same event
+    // loop pass (an import, a merge) share one
+    void onCatalogPublished();
+
+    // rebuild: Index the library's current version and refresh results
+    void rebuild();
+
 private:
     // ========== Private Member Variables ==========
-    
-    // m_results: List of books that match the current search criteria
-    QList<BookResult> m_results;
+
+    // m_library: Owner of the catalog being searched
+    LibraryModel *m_library;
+
+    // m_index: Publishes the index of the library's current version
+    // (the index carries the snapshot it was built from)
+    AtomicVersion<SearchIndex> m_index;
+
+    // m_results: Books that match the current search criteria
+    // Model state: read and replaced on the GUI thread only, like any
+    // QAbstractListModel data; other threads use searchIndex() instead
+    CatalogSnapshotPtr m_results;
 
     // m_currentSearch: The current search query being used
     QString m_currentSearch;
 
-    // m_allBooks: Cache of all books from the database for searching
-    QList<BookResult> m_allBooks;
+    // m_rebuildTimer: Zero-interval single shot that runs rebuild()
+    QTimer m_rebuildTimer;
 
-    // ========== Private Methods ==========
-
-    // loadAllBooks: Load all books from database into memory for searching
-    // This is called once to cache all books for fast searching
-    void loadAllBooks();
+    // m_searchType / m_searchFromDatabase / m_searchActive: How the current
+    // results were produced, so they can be re-run on a new catalog version
+    QString m_searchType;
+    bool m_searchFromDatabase = false;
+    bool m_searchActive = false;
 
-    // performTitleSearch: Search books by title (case-insensitive)
-    void performTitleSearch(const QString &query);
+    // ========== Private Methods ==========
 
-    // performAuthorSearch: Search books by author (case-insensitive)
-    void performAuthorSearch(const QString &query);
+    // updateIndex: Index the library's current version now, unless already
+    // indexed; cancels a pending rebuild, as the caller refreshes results
+    void updateIndex();
 
-    // performStatusSearch: Filter books by exact status (SHELF, LOANED, BORROWED)
-    void performStatusSearch(const QString &status);
+    // runSearch: Evaluate the current search into m_results
+    // (no model notifications; callers wrap it in a reset)
+    void runSearch();
 
-    // performFullSearch: Search both title and author fields
-    void performFullSearch(const QString &query);
+    // databaseResults: Books matching a query in PostgreSQL, in catalog order
+    QList<Book> databaseResults(const SearchQuery &query) const;
 };
 
 #endif // SEARCHMODEL_H
@@ -8,6 +8,7 @@ import QtQuick.Layouts
 // FEATURES:
 //   - Real-time search as user types
 //   - Filter by title, author, or status
+//   - Structured queries: author:king status:LOANED "dark tower" -contact:john
 //   - Display search results in a grid view
 //   - Shows result count
 //   - Links to edit/delete functionality
@@ -42,13 +43,18 @@ Rectangle {
         
         // When timer fires, execute the search
         onTriggered: {
-            executeSearch()
+            executeSearch(false)
         }
     }
     
     // ========== HELPER FUNCTION ==========
     // This function executes the search based on current UI state
-    function executeSearch() {
+    // fromDatabase: true to run the query in PostgreSQL, which also sees
+    //               books changed by other clients (Enter / Search button);
+    //               false to search the in-memory catalog (fast, while typing).
+    //               The in-memory catalog follows every change made in this
+    //               app, so both agree unless another client edited the table.
+    function executeSearch(fromDatabase) {
         // Show loading indicator
         searchBusy.running = true
         
@@ -66,7 +72,11 @@ Rectangle {
             console.log("Executing search: query='" + searchInput.text + "', type='" + searchType + "'")
             
             // Execute the search in C++ model
-            searchModel.performSearch(searchInput.text, searchType)
+            if (fromDatabase) {
+                searchModel.performDatabaseSearch(searchInput.text, searchType)
+            } else {
+                searchModel.performSearch(searchInput.text, searchType)
+            }
             
             // DEBUG: Log the number of results
             console.log("Search returned " + searchModel.resultCount + " results")
@@ -144,13 +154,13 @@ Rectangle {
                             // Text input field - user types here
                             TextField {
                                 id: searchInput
-                                placeholderText: "Enter book title, author, or status..."
+                                placeholderText: "Title or author, or e.g. author:king status:LOANED -contact:john"
                                 Layout.fillWidth: true
                                 background: Rectangle { color: "transparent" }
                                 
                                 // Handle Enter key press for search
                                 onAccepted: {
-                                    executeSearch()
+                                    executeSearch(true)
                                 }
                                 
                                 // Trigger search as user types (real-time search with delay)
@@ -202,7 +212,7 @@ Rectangle {
                         }
                         
                         // Execute search when clicked
-                        onClicked: executeSearch()
+                        onClicked: executeSearch(true)
                     }
                     
                     // Clear search button
@@ -0,0 +1,150 @@
+// SearchQuery.cpp
+// ============================================================================
+// Implementation of the structured search query parser and SQL compiler
+// ============================================================================
+
+#include "SearchQuery.h"
+#include <QStringList>
+
+namespace {
+
+// fieldFromName: Recognize a "field:" prefix; returns false for unknown names
+// so that text such as "re:zero" is searched for literally
+bool fieldFromName(const QString &name, SearchTerm::Field &field)
+{
+    if (name == "title") field = SearchTerm::Title;
+    else if (name == "author") field = SearchTerm::Author;
+    else if (name == "status") field = SearchTerm::Status;
+    else if (name == "contact") field = SearchTerm::Contact;
+    else return false;
+    return true;
+}
+
+// likePattern: Substring pattern for ILIKE with wildcards in the value escaped
+QString likePattern(const QString &value)
+{
+    QString escaped = value;
+    escaped.replace('\\', "\\\\");
+    escaped.replace('%', "\\%");
+    escaped.replace('_', "\\_");
+    return '%' + escaped + '%';
+}
+
+} // namespace
+
+// ============================================================================
+// PARSING
+// ============================================================================
+
+SearchQuery SearchQuery::parse(const QString &text, SearchTerm::Field defaultField)
+{
+    SearchQuery query;
+    const int length = text.size();
+    int pos = 0;
+
+    while (pos < length) {
+        // Skip whitespace between terms
+        if (text[pos].isSpace()) {
+            pos++;
+            continue;
+        }
+
+        SearchTerm term;
+        term.field = defaultField;
+        term.negated = false;
+
+        // Leading "-" excludes matches; a lone "-" is not a term at all
+        if (text[pos] == '-') {
+            if (pos + 1 == length || text[pos + 1].isSpace()) {
+                pos++;
+                continue;
+            }
+            term.negated = true;
+            pos++;
+        }
+
+        // Optional "field:" prefix
+        int wordEnd = pos;
+        while (wordEnd < length && text[wordEnd].isLetter())
+            wordEnd++;
+        if (wordEnd < length && wordEnd > pos && text[wordEnd] == ':') {
+            SearchTerm::Field field;
+            if (fieldFromName(text.mid(pos, wordEnd - pos).toLower(), field)) {
+                term.field = field;
+                pos = wordEnd + 1;
+            }
+        }
+
+        // Value: quoted phrase or a single word
+        if (pos < length && text[pos] == '"') {
+            const int close = text.indexOf('"', pos + 1);
+            const int end = close < 0 ? length : close;
+            term.value = text.mid(pos + 1, end - pos - 1).trimmed();
+            pos = end + 1;
+        } else {
+            const int start = pos;
+            while (pos < length && !text[pos].isSpace())
+                pos++;
+            term.value = text.mid(start, pos - start);
+        }
+
+        if (term.value.isEmpty())
+            continue;  // e.g. a dangling "author:"
+
+        term.value = term.field == SearchTerm::Status ? term.value.toUpper() : term.value.toCaseFolded();
+        query.m_terms.append(term);
+    }
+
+    return query;
+}
+
+SearchTerm::Field SearchQuery::fieldFromSearchType(const QString &searchType)
+{
+    SearchTerm::Field field;
+    if (fieldFromName(searchType, field) && field != SearchTerm::Contact)
+        return field;
+    return SearchTerm::Any;
+}
+
+// ============================================================================
+// SQL COMPILATION
+// ============================================================================
+
+// toSqlWhere: Each term becomes one AND-ed clause; values are always bound,
+// never spliced into the SQL text
+QString SearchQuery::toSqlWhere(QVariantList &bindValues) const
+{
+    QStringList clauses;
+
+    for (const SearchTerm &term : m_terms) {
+        QString clause;
+
+        switch (term.field) {
+        case SearchTerm::Title:
+            clause = "title ILIKE ? ESCAPE '\\'";
+            bindValues << likePattern(term.value);
+            break;
+        case SearchTerm::Author:
+            clause = "author ILIKE ? ESCAPE '\\'";
+            bindValues << likePattern(term.value);
+            break;
+        case SearchTerm::Status:
+            clause = "status = ?";
+            bindValues << term.value;
+            break;
+        case SearchTerm::Contact:
+            clause = "(COALESCE(contact_name, '') ILIKE ? ESCAPE '\\' "
+                     "OR COALESCE(contact_number, '') ILIKE ? ESCAPE '\\')";
+            bindValues << likePattern(term.value) << likePattern(term.value);
+            break;
+        case SearchTerm::Any:
+            clause = "(title ILIKE ? ESCAPE '\\' OR author ILIKE ? ESCAPE '\\')";
+            bindValues << likePattern(term.value) << likePattern(term.value);
+            break;
+        }
+
+        clauses << (term.negated ? "NOT " + clause : clause);
+    }
+
+    return clauses.join(" AND ");
+}
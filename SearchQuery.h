@@ -0,0 +1,66 @@
+// SearchQuery.h
+// ============================================================================
+// Purpose: Parses the structured search syntax used by the search page
+// Syntax:
+//   author:king status:LOANED "dark tower" -contact:john
+//   - field:value      restrict a term to one field
+//                      (title, author, status, contact)
+//   - "quoted text"    phrase, may contain spaces (also as field:"...")
+//   - -term            exclude books matching the term
+//   - bare words       match the default field (title or author for "all")
+// Responsibilities:
+//   - Splits the query text into a flat list of AND-ed terms
+//   - Compiles terms into a SQL WHERE clause for database-side searching
+// ============================================================================
+
+#ifndef SEARCHQUERY_H
+#define SEARCHQUERY_H
+
+#include <QList>
+#include <QString>
+#include <QVariantList>
+
+// SearchTerm - one predicate of a parsed query
+struct SearchTerm {
+    enum Field {
+        Any,        // Title or author
+        Title,
+        Author,
+        Status,     // Exact match against SHELF, LOANED, BORROWED
+        Contact     // Contact name or contact number
+    };
+
+    Field field;
+    QString value;      // Case-folded text, or upper-cased status
+    bool negated;       // True for "-field:value"
+};
+
+class SearchQuery
+{
+public:
+    // parse: Build a query from user input
+    // Parameters:
+    //   - text: The raw query string
+    //   - defaultField: Field used for terms without a "field:" prefix
+    static SearchQuery parse(const QString &text, SearchTerm::Field defaultField = SearchTerm::Any);
+
+    // fieldFromSearchType: Map the search page's filter names
+    // ("all", "title", "author", "status") to a default field
+    static SearchTerm::Field fieldFromSearchType(const QString &searchType);
+
+    // terms: All parsed terms; every term must hold for a book to match
+    const QList<SearchTerm> &terms() const { return m_terms; }
+
+    bool isEmpty() const { return m_terms.isEmpty(); }
+
+    // toSqlWhere: Compile the terms into a WHERE clause (without "WHERE"),
+    // one clause per term in query order
+    // Parameters:
+    //   - bindValues: Receives one value per positional "?" placeholder
+    QString toSqlWhere(QVariantList &bindValues) const;
+
+private:
+    QList<SearchTerm> m_terms;
+};
+
+#endif // SEARCHQUERY_H
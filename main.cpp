@@ -5,6 +5,7 @@
 #include "DatabaseManager.h"
 #include "LibraryModel.h"
 #include "SearchModel.h"
+#include "DuplicateDetector.h"
 
 int main(int argc, char *argv[])
 {
@@ -32,10 +33,18 @@ int main(int argc, char *argv[])
     LibraryModel libraryModel;
     engine.rootContext()->setContextProperty("libraryModel", &libraryModel);
 
-    // Register SearchModel - Search and filter model
-    SearchModel searchModel;
+    // Register SearchModel - Search and filter model over the library's catalog
+    SearchModel searchModel(&libraryModel);
     engine.rootContext()->setContextProperty("searchModel", &searchModel);
 
+    // Register DuplicateDetector - Near-duplicate checks over the library
+    DuplicateDetector duplicateDetector;
+    duplicateDetector.setSnapshot(libraryModel.snapshot());
+    QObject::connect(&libraryModel, &LibraryModel::catalogPublished, &duplicateDetector, [&]() {
+        duplicateDetector.setSnapshot(libraryModel.snapshot());
+    });
+    engine.rootContext()->setContextProperty("duplicateDetector", &duplicateDetector);
+
     QObject::connect(
         &engine,
         &QQmlApplicationEngine::objectCreationFailed,
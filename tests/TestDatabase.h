@@ -0,0 +1,38 @@
+// TestDatabase.h
+// ============================================================================
+// Purpose: In-memory stand-in for the PostgreSQL books table
+// The models use the default connection, so tests open this one instead of
+// calling DatabaseManager::connectToDatabase(). SQLite understands the SQL
+// the models send (including RETURNING and UPDATE ... FROM), but not ILIKE.
+// ============================================================================
+
+#ifndef TESTDATABASE_H
+#define TESTDATABASE_H
+
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QDebug>
+
+// openTestDatabase: Open the default connection on an empty in-memory
+// database with the schema from create_db.sql
+inline bool openTestDatabase()
+{
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(":memory:");
+    if (!db.open()) {
+        qCritical() << "Failed to open test database:" << db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query;
+    if (!query.exec("CREATE TABLE books (id INTEGER PRIMARY KEY, title TEXT NOT NULL, "
+                    "author TEXT NOT NULL, status TEXT NOT NULL DEFAULT 'SHELF', "
+                    "contact_name TEXT, contact_number TEXT)")) {
+        qCritical() << "Failed to create test table:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+#endif // TESTDATABASE_H
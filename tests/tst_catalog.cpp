@@ -0,0 +1,270 @@
+// tst_catalog.cpp
+// ============================================================================
+// Purpose: Unit tests for the chunked, persistent CatalogSnapshot
+// Responsibilities:
+//   - Row lookup across chunk boundaries and after edits
+//   - inserted() splitting a chunk once it reaches 2 * kChunkSize
+//   - removed() dropping chunks that become empty
+//   - replaced() at chunk boundaries
+//   - Earlier snapshots never change when a new version is derived
+// ============================================================================
+
+#include <QtTest>
+#include "Catalog.h"
+
+namespace {
+
+constexpr int kChunk = CatalogSnapshot::kChunkSize;
+
+Book makeBook(int id)
+{
+    return { id, QString("Book %1").arg(id), "Author", "SHELF", "", "" };
+}
+
+QList<Book> makeBooks(int count, int firstId = 0)
+{
+    QList<Book> books;
+    for (int i = 0; i < count; ++i)
+        books.append(makeBook(firstId + i));
+    return books;
+}
+
+// ids: Book ids of a snapshot read three ways; all must agree
+QList<int> ids(const CatalogSnapshot &snapshot)
+{
+    QList<int> byRow;
+    for (int row = 0; row < snapshot.count(); ++row)
+        byRow.append(snapshot.at(row).id);
+
+    QList<int> byList;
+    for (const Book &book : snapshot.toList())
+        byList.append(book.id);
+
+    QList<int> byVisit;
+    snapshot.forEach([&byVisit](const Book &book) { byVisit.append(book.id); });
+
+    if (byList != byRow || byVisit != byRow)
+        qWarning() << "at(), toList() and forEach() disagree";
+    return byList == byRow && byVisit == byRow ? byRow : QList<int>();
+}
+
+QList<int> range(int first, int count)
+{
+    QList<int> result;
+    for (int i = 0; i < count; ++i)
+        result.append(first + i);
+    return result;
+}
+
+} // namespace
+
+class tst_Catalog : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void emptySnapshot();
+    void chunkBoundaries();
+    void indexOfId();
+    void insertAtFrontUntilSplit();
+    void insertAtEveryPosition();
+    void appendAtCount();
+    void removeEveryRowOfChunk();
+    void removeEverything();
+    void replaceAtBoundaries();
+    void oldSnapshotsStayUnchanged();
+    void catalogPublishes();
+};
+
+void tst_Catalog::emptySnapshot()
+{
+    const CatalogSnapshot empty;
+    QVERIFY(empty.isEmpty());
+    QCOMPARE(empty.count(), 0);
+    QVERIFY(empty.toList().isEmpty());
+    QCOMPARE(empty.indexOfId(1), -1);
+
+    const CatalogSnapshotPtr one = empty.inserted(0, makeBook(7));
+    QCOMPARE(ids(*one), QList<int>({ 7 }));
+    QVERIFY(empty.isEmpty());
+}
+
+// chunkBoundaries: Rows on both sides of every chunk edge, including a
+// short last chunk
+void tst_Catalog::chunkBoundaries()
+{
+    const int count = 2 * kChunk + 5;
+    const CatalogSnapshot snapshot(makeBooks(count));
+
+    QCOMPARE(snapshot.count(), count);
+    for (int row : { 0, kChunk - 1, kChunk, kChunk + 1, 2 * kChunk - 1, 2 * kChunk, count - 1 })
+        QCOMPARE(snapshot.at(row).id, row);
+    QCOMPARE(ids(snapshot), range(0, count));
+}
+
+void tst_Catalog::indexOfId()
+{
+    const CatalogSnapshot snapshot(makeBooks(2 * kChunk, 100));
+    QCOMPARE(snapshot.indexOfId(100), 0);
+    QCOMPARE(snapshot.indexOfId(100 + kChunk), kChunk);
+    QCOMPARE(snapshot.indexOfId(100 + 2 * kChunk - 1), 2 * kChunk - 1);
+    QCOMPARE(snapshot.indexOfId(99), -1);
+}
+
+// insertAtFrontUntilSplit: New books go to row 0 (newest first, as in the
+// app); the first chunk grows to 2 * kChunkSize and splits, repeatedly
+void tst_Catalog::insertAtFrontUntilSplit()
+{
+    CatalogSnapshotPtr snapshot = std::make_shared<const CatalogSnapshot>(makeBooks(kChunk));
+    QList<int> expected = range(0, kChunk);
+
+    for (int i = 0; i < 3 * kChunk; ++i) {
+        const int id = 1000 + i;
+        snapshot = snapshot->inserted(0, makeBook(id));
+        expected.prepend(id);
+
+        QCOMPARE(snapshot->count(), expected.count());
+        QCOMPARE(snapshot->at(0).id, id);
+        QCOMPARE(snapshot->at(snapshot->count() - 1).id, kChunk - 1);
+    }
+    QCOMPARE(ids(*snapshot), expected);
+    QCOMPARE(snapshot->indexOfId(0), 3 * kChunk);
+}
+
+// insertAtEveryPosition: Inserts at chunk starts, ends and middles keep the
+// offsets of every later chunk right
+void tst_Catalog::insertAtEveryPosition()
+{
+    CatalogSnapshotPtr snapshot = std::make_shared<const CatalogSnapshot>(makeBooks(2 * kChunk + 3));
+    QList<int> expected = range(0, 2 * kChunk + 3);
+
+    int id = 5000;
+    for (int row : { kChunk, kChunk - 1, 1, 2 * kChunk, kChunk + 1, 0 }) {
+        for (int repeat = 0; repeat < kChunk + 1; ++repeat) {
+            snapshot = snapshot->inserted(row, makeBook(id));
+            expected.insert(row, id);
+            id++;
+        }
+        QCOMPARE(ids(*snapshot), expected);
+    }
+}
+
+// appendAtCount: row == count() appends to the last chunk
+void tst_Catalog::appendAtCount()
+{
+    CatalogSnapshotPtr snapshot = std::make_shared<const CatalogSnapshot>(makeBooks(kChunk + 1));
+    QList<int> expected = range(0, kChunk + 1);
+
+    for (int i = 0; i < 2 * kChunk + 1; ++i) {
+        snapshot = snapshot->inserted(snapshot->count(), makeBook(9000 + i));
+        expected.append(9000 + i);
+    }
+    QCOMPARE(ids(*snapshot), expected);
+}
+
+// removeEveryRowOfChunk: Emptying the middle chunk drops it; the rows
+// after it move up
+void tst_Catalog::removeEveryRowOfChunk()
+{
+    const int count = 2 * kChunk + 2;
+    CatalogSnapshotPtr snapshot = std::make_shared<const CatalogSnapshot>(makeBooks(count));
+    QList<int> expected = range(0, count);
+
+    for (int i = 0; i < kChunk; ++i) {
+        snapshot = snapshot->removed(kChunk);
+        expected.removeAt(kChunk);
+        QCOMPARE(snapshot->count(), expected.count());
+    }
+    QCOMPARE(ids(*snapshot), expected);
+    QCOMPARE(snapshot->at(kChunk - 1).id, kChunk - 1);
+    QCOMPARE(snapshot->at(kChunk).id, 2 * kChunk);
+
+    // Rows can still be inserted where the dropped chunk was
+    snapshot = snapshot->inserted(kChunk, makeBook(-1));
+    expected.insert(kChunk, -1);
+    QCOMPARE(ids(*snapshot), expected);
+}
+
+void tst_Catalog::removeEverything()
+{
+    CatalogSnapshotPtr snapshot = std::make_shared<const CatalogSnapshot>(makeBooks(kChunk + 3));
+    while (!snapshot->isEmpty())
+        snapshot = snapshot->removed(snapshot->count() - 1);
+    QCOMPARE(snapshot->count(), 0);
+    QVERIFY(snapshot->toList().isEmpty());
+
+    snapshot = snapshot->inserted(0, makeBook(1));
+    QCOMPARE(ids(*snapshot), QList<int>({ 1 }));
+}
+
+void tst_Catalog::replaceAtBoundaries()
+{
+    const int count = 2 * kChunk + 1;
+    CatalogSnapshotPtr snapshot = std::make_shared<const CatalogSnapshot>(makeBooks(count));
+    QList<int> expected = range(0, count);
+
+    for (int row : { 0, kChunk - 1, kChunk, 2 * kChunk - 1, 2 * kChunk }) {
+        snapshot = snapshot->replaced(row, makeBook(-row - 1));
+        expected[row] = -row - 1;
+    }
+    QCOMPARE(ids(*snapshot), expected);
+    QCOMPARE(snapshot->at(kChunk).title, QString("Book %1").arg(-kChunk - 1));
+}
+
+// oldSnapshotsStayUnchanged: Every version derived along the way still
+// reads exactly as it did when it was created
+void tst_Catalog::oldSnapshotsStayUnchanged()
+{
+    const QList<Book> initialBooks = makeBooks(2 * kChunk + 7);
+    const CatalogSnapshotPtr initial = std::make_shared<const CatalogSnapshot>(initialBooks);
+
+    QList<CatalogSnapshotPtr> versions = { initial };
+    QList<QList<int>> states = { ids(*initial) };
+
+    CatalogSnapshotPtr current = initial;
+    for (int i = 0; i < 2 * kChunk; ++i) {
+        switch (i % 3) {
+        case 0:
+            current = current->inserted(0, makeBook(1000 + i));
+            break;
+        case 1:
+            current = current->replaced(kChunk, makeBook(2000 + i));
+            break;
+        case 2:
+            current = current->removed(current->count() / 2);
+            break;
+        }
+        versions.append(current);
+        states.append(ids(*current));
+    }
+
+    for (int v = 0; v < versions.count(); ++v)
+        QCOMPARE(ids(*versions[v]), states[v]);
+
+    const QList<Book> initialNow = initial->toList();
+    QCOMPARE(initialNow.count(), initialBooks.count());
+    for (int i = 0; i < initialBooks.count(); ++i) {
+        QCOMPARE(initialNow[i].id, initialBooks[i].id);
+        QCOMPARE(initialNow[i].title, initialBooks[i].title);
+    }
+}
+
+// catalogPublishes: Readers keep the version they loaded
+void tst_Catalog::catalogPublishes()
+{
+    Catalog catalog;
+    QVERIFY(catalog.snapshot());
+    QVERIFY(catalog.snapshot()->isEmpty());
+
+    const CatalogSnapshotPtr first = std::make_shared<const CatalogSnapshot>(makeBooks(3));
+    catalog.publish(first);
+    const CatalogSnapshotPtr held = catalog.snapshot();
+    QCOMPARE(held.get(), first.get());
+
+    catalog.publish(held->removed(0));
+    QCOMPARE(catalog.snapshot()->count(), 2);
+    QCOMPARE(ids(*held), QList<int>({ 0, 1, 2 }));
+}
+
+QTEST_APPLESS_MAIN(tst_Catalog)
+#include "tst_catalog.moc"
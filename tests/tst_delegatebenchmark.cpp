@@ -0,0 +1,150 @@
+// tst_delegatebenchmark.cpp
+// ============================================================================
+// Purpose: Measures BooksGrid delegate creation over a large library
+// Responsibilities:
+//   - Fills an in-memory SQLite books table with several thousand rows and
+//     loads them through LibraryModel
+//   - Scrolls BooksGrid.qml from top to bottom under QBENCHMARK, so every
+//     row gets a delegate
+//   - Counts data() and multiData() calls to show which path the Qt Quick
+//     delegates actually take
+// ============================================================================
+
+#include <QtTest>
+#include <QQuickItem>
+#include <QQuickView>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include "LibraryModel.h"
+#include "TestDatabase.h"
+
+namespace {
+
+constexpr int kBookCount = 5000;
+
+// CountingLibraryModel: LibraryModel that records how views read it
+class CountingLibraryModel : public LibraryModel
+{
+public:
+    using LibraryModel::LibraryModel;
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        dataCalls++;
+        return LibraryModel::data(index, role);
+    }
+
+    void multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const override
+    {
+        multiDataCalls++;
+        LibraryModel::multiData(index, roleDataSpan);
+    }
+
+    mutable int dataCalls = 0;
+    mutable int multiDataCalls = 0;
+};
+
+} // namespace
+
+class tst_DelegateBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void delegatesUseMultiData();
+    void createDelegates();
+
+private:
+    // loadGrid: Show BooksGrid.qml over the model; returns its GridView
+    QQuickItem *loadGrid(QQuickView &view, LibraryModel *model);
+
+    // scrollThrough: Scroll the grid page by page from the top to the end
+    void scrollThrough(QQuickItem *grid);
+};
+
+// initTestCase: Same schema as create_db.sql, in an in-memory database that
+// LibraryModel reaches through the default connection
+void tst_DelegateBenchmark::initTestCase()
+{
+    QVERIFY(openTestDatabase());
+    QSqlDatabase db = QSqlDatabase::database();
+
+    QSqlQuery query;
+    const QStringList statuses = { "SHELF", "LOANED", "BORROWED" };
+    QVERIFY(db.transaction());
+    query.prepare("INSERT INTO books (title, author, status, contact_name, contact_number) "
+                  "VALUES (?, ?, ?, ?, ?)");
+    for (int i = 0; i < kBookCount; ++i) {
+        const QString status = statuses[i % statuses.count()];
+        query.addBindValue(QString("Book %1").arg(i));
+        query.addBindValue(QString("Author %1").arg(i % 250));
+        query.addBindValue(status);
+        query.addBindValue(status == "SHELF" ? QString() : QString("Contact %1").arg(i));
+        query.addBindValue(status == "SHELF" ? QString() : QString("555-%1").arg(i, 4, 10, QChar('0')));
+        QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+    }
+    QVERIFY(db.commit());
+}
+
+QQuickItem *tst_DelegateBenchmark::loadGrid(QQuickView &view, LibraryModel *model)
+{
+    view.setInitialProperties({ { "bookModel", QVariant::fromValue<QObject *>(model) } });
+    view.setResizeMode(QQuickView::SizeRootObjectToView);
+    view.resize(1000, 800);
+    view.setSource(QUrl::fromLocalFile(QStringLiteral(MWANATECH_SOURCE_DIR "/BooksGrid.qml")));
+    if (view.status() != QQuickView::Ready)
+        return nullptr;
+
+    view.show();
+    if (!QTest::qWaitForWindowExposed(&view))
+        return nullptr;
+    return view.rootObject()->findChild<QQuickItem *>("booksGridView");
+}
+
+void tst_DelegateBenchmark::scrollThrough(QQuickItem *grid)
+{
+    const qreal page = grid->height();
+    const qreal end = grid->property("contentHeight").toReal();
+    for (qreal y = 0; y < end; y += page) {
+        grid->setProperty("contentY", y);
+        QCoreApplication::processEvents();
+    }
+    grid->setProperty("contentY", 0);
+    QCoreApplication::processEvents();
+}
+
+// delegatesUseMultiData: The multiData() override only helps if the
+// delegate path calls it; fail loudly if Qt Quick reads roles one by one
+void tst_DelegateBenchmark::delegatesUseMultiData()
+{
+    CountingLibraryModel model;
+    QCOMPARE(model.rowCount(), kBookCount);
+
+    QQuickView view;
+    QQuickItem *grid = loadGrid(view, &model);
+    QVERIFY2(grid, qPrintable(view.errors().isEmpty() ? QString("GridView not found")
+                                                      : view.errors().first().toString()));
+
+    scrollThrough(grid);
+
+    qInfo() << "data() calls:" << model.dataCalls << "multiData() calls:" << model.multiDataCalls;
+    QVERIFY2(model.multiDataCalls > 0, "BooksGrid delegates never called multiData()");
+}
+
+// createDelegates: Cost of creating a delegate for every row of the library
+void tst_DelegateBenchmark::createDelegates()
+{
+    LibraryModel model;
+    QQuickView view;
+    QQuickItem *grid = loadGrid(view, &model);
+    QVERIFY(grid);
+
+    QBENCHMARK {
+        scrollThrough(grid);
+    }
+}
+
+QTEST_MAIN(tst_DelegateBenchmark)
+#include "tst_delegatebenchmark.moc"
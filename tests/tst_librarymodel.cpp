@@ -0,0 +1,215 @@
+// tst_librarymodel.cpp
+// ============================================================================
+// Purpose: Unit tests for LibraryModel::mergeBooks against an in-memory
+//          SQLite books table
+// Responsibilities:
+//   - The loan state survives a merge (status and contact move together)
+//   - Conflicting loans are refused and leave both records untouched
+//   - Nothing is deleted when the kept record could not be updated
+//   - catalogPublished() follows the model's end notification
+// ============================================================================
+
+#include <QtTest>
+#include "LibraryModel.h"
+#include "TestDatabase.h"
+
+namespace {
+
+void insertBook(int id, const QString &title, const QString &status,
+                const QString &contactName = QString(), const QString &contactNumber = QString())
+{
+    QSqlQuery query;
+    query.prepare("INSERT INTO books (id, title, author, status, contact_name, contact_number) "
+                  "VALUES (?, ?, 'Stephen King', ?, ?, ?)");
+    query.addBindValue(id);
+    query.addBindValue(title);
+    query.addBindValue(status);
+    query.addBindValue(contactName);
+    query.addBindValue(contactNumber);
+    if (!query.exec())
+        qCritical() << "Failed to insert test book:" << query.lastError().text();
+}
+
+// stored: "status|contact_name|contact_number" of a record, or "" if gone
+QString stored(int id)
+{
+    QSqlQuery query;
+    query.prepare("SELECT status, contact_name, contact_number FROM books WHERE id = ?");
+    query.addBindValue(id);
+    if (!query.exec() || !query.next())
+        return QString();
+    return query.value(0).toString() + '|' + query.value(1).toString() + '|' + query.value(2).toString();
+}
+
+} // namespace
+
+class tst_LibraryModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+
+    void mergeTakesDuplicateLoan();
+    void mergeKeepsKeeperLoan();
+    void mergeFillsEmptyContactOfSameLoan();
+    void mergeRefusesLoanedAndBorrowed();
+    void mergeRefusesLoansToDifferentPeople_data();
+    void mergeRefusesLoansToDifferentPeople();
+    void mergeRefusesMissingRecord();
+    void mergeRefusesSameRecord();
+
+    void publishesAfterViewsAreNotified();
+};
+
+void tst_LibraryModel::initTestCase()
+{
+    QVERIFY(openTestDatabase());
+}
+
+// init: Every test starts from an empty table
+void tst_LibraryModel::init()
+{
+    QSqlQuery query;
+    QVERIFY(query.exec("DELETE FROM books"));
+}
+
+// mergeTakesDuplicateLoan: Keeper on the shelf, duplicate lent out; the
+// keeper takes over the loan with its contact details
+void tst_LibraryModel::mergeTakesDuplicateLoan()
+{
+    insertBook(1, "The Dark Tower", "SHELF");
+    insertBook(2, "Dark Tower, The", "LOANED", "John", "555-0101");
+
+    LibraryModel model;
+    QCOMPARE(model.rowCount(), 2);
+    QVERIFY(model.mergeBooks(1, 2));
+
+    QCOMPARE(stored(1), QString("LOANED|John|555-0101"));
+    QCOMPARE(stored(2), QString());
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.getLoanedCount(), 1);
+}
+
+void tst_LibraryModel::mergeKeepsKeeperLoan()
+{
+    insertBook(1, "The Dark Tower", "BORROWED", "Mary", "555-0102");
+    insertBook(2, "Dark Tower, The", "SHELF");
+
+    LibraryModel model;
+    QVERIFY(model.mergeBooks(1, 2));
+
+    QCOMPARE(stored(1), QString("BORROWED|Mary|555-0102"));
+    QCOMPARE(stored(2), QString());
+}
+
+// mergeFillsEmptyContactOfSameLoan: Same loan recorded twice, each record
+// holding part of the contact details
+void tst_LibraryModel::mergeFillsEmptyContactOfSameLoan()
+{
+    insertBook(1, "The Dark Tower", "LOANED", "John", "");
+    insertBook(2, "Dark Tower, The", "LOANED", "John", "555-0101");
+
+    LibraryModel model;
+    QVERIFY(model.mergeBooks(1, 2));
+
+    QCOMPARE(stored(1), QString("LOANED|John|555-0101"));
+    QCOMPARE(stored(2), QString());
+}
+
+void tst_LibraryModel::mergeRefusesLoanedAndBorrowed()
+{
+    insertBook(1, "The Dark Tower", "LOANED", "John", "555-0101");
+    insertBook(2, "Dark Tower, The", "BORROWED", "Mary", "555-0102");
+
+    LibraryModel model;
+    QVERIFY(!model.mergeBooks(1, 2));
+
+    QCOMPARE(stored(1), QString("LOANED|John|555-0101"));
+    QCOMPARE(stored(2), QString("BORROWED|Mary|555-0102"));
+    QCOMPARE(model.rowCount(), 2);
+}
+
+// mergeRefusesLoansToDifferentPeople: Two copies lent to two people are two
+// physical books; merging would delete one loan
+void tst_LibraryModel::mergeRefusesLoansToDifferentPeople_data()
+{
+    QTest::addColumn<QString>("status");
+    QTest::addColumn<QString>("keepName");
+    QTest::addColumn<QString>("keepNumber");
+    QTest::addColumn<QString>("duplicateName");
+    QTest::addColumn<QString>("duplicateNumber");
+
+    QTest::newRow("loaned, different names") << "LOANED" << "John" << "555-0101" << "Mary" << "555-0101";
+    QTest::newRow("loaned, different numbers") << "LOANED" << "John" << "555-0101" << "John" << "555-0199";
+    QTest::newRow("borrowed, different names") << "BORROWED" << "John" << "" << "Mary" << "";
+}
+
+void tst_LibraryModel::mergeRefusesLoansToDifferentPeople()
+{
+    QFETCH(QString, status);
+    QFETCH(QString, keepName);
+    QFETCH(QString, keepNumber);
+    QFETCH(QString, duplicateName);
+    QFETCH(QString, duplicateNumber);
+
+    insertBook(1, "The Dark Tower", status, keepName, keepNumber);
+    insertBook(2, "Dark Tower, The", status, duplicateName, duplicateNumber);
+
+    LibraryModel model;
+    QVERIFY(!model.mergeBooks(1, 2));
+
+    QCOMPARE(stored(1), status + '|' + keepName + '|' + keepNumber);
+    QCOMPARE(stored(2), status + '|' + duplicateName + '|' + duplicateNumber);
+}
+
+// mergeRefusesMissingRecord: A stale report must not delete anything
+void tst_LibraryModel::mergeRefusesMissingRecord()
+{
+    insertBook(2, "Dark Tower, The", "LOANED", "John", "555-0101");
+
+    LibraryModel model;
+    QVERIFY(!model.mergeBooks(1, 2));
+    QCOMPARE(stored(2), QString("LOANED|John|555-0101"));
+}
+
+void tst_LibraryModel::mergeRefusesSameRecord()
+{
+    insertBook(1, "The Dark Tower", "SHELF");
+
+    LibraryModel model;
+    QVERIFY(!model.mergeBooks(1, 1));
+    QCOMPARE(stored(1), QString("SHELF||"));
+}
+
+// publishesAfterViewsAreNotified: Listeners of catalogPublished() may read
+// the model, so it must not fire between begin and end notifications
+void tst_LibraryModel::publishesAfterViewsAreNotified()
+{
+    insertBook(1, "The Dark Tower", "SHELF");
+
+    LibraryModel model;
+    QStringList events;
+    connect(&model, &QAbstractItemModel::rowsInserted, this, [&events]() { events << "inserted"; });
+    connect(&model, &QAbstractItemModel::dataChanged, this, [&events]() { events << "changed"; });
+    connect(&model, &QAbstractItemModel::rowsRemoved, this, [&events]() { events << "removed"; });
+    connect(&model, &QAbstractItemModel::modelReset, this, [&events]() { events << "reset"; });
+    connect(&model, &LibraryModel::catalogPublished, this, [&events, &model]() {
+        events << QString("published %1").arg(model.snapshot()->count());
+    });
+
+    model.addBook("The Stand", "Stephen King", "SHELF", "", "");
+    const int id = model.snapshot()->at(0).id;
+    model.updateBook(id, "The Stand", "Stephen King", "LOANED", "John", "555-0101");
+    model.removeBook(0);
+    model.refresh();
+
+    QCOMPARE(events, QStringList({ "inserted", "published 2",
+                                   "changed", "published 2",
+                                   "removed", "published 1",
+                                   "reset", "published 1" }));
+}
+
+QTEST_GUILESS_MAIN(tst_LibraryModel)
+#include "tst_librarymodel.moc"
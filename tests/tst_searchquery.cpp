@@ -0,0 +1,297 @@
+// tst_searchquery.cpp
+// ============================================================================
+// Purpose: Unit tests for the structured search parser, its SQL translation
+//          and the in-memory query planner
+// Responsibilities:
+//   - Edge cases of SearchQuery::parse (dangling prefixes, unclosed quotes,
+//     lone "-", negation-only queries)
+//   - Escaping of LIKE wildcards in SearchQuery::toSqlWhere bind values
+//   - SearchIndex driver selection, short-circuiting and full scans
+//   - The index, the term values and matches() share one case folding
+// ============================================================================
+
+#include <QtTest>
+#include "Catalog.h"
+#include "SearchIndex.h"
+#include "SearchQuery.h"
+
+namespace {
+
+// titles: Titles of a result list, in order
+QStringList titles(const QList<Book> &books)
+{
+    QStringList result;
+    for (const Book &book : books)
+        result << book.title;
+    return result;
+}
+
+} // namespace
+
+class tst_SearchQuery : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // ========== Parser ==========
+    void parseFieldsAndPhrases();
+    void parseDanglingField();
+    void parseUnclosedQuote();
+    void parseLoneMinus();
+    void parseNegationOnly();
+    void parseUnknownField();
+
+    // ========== SQL Translation ==========
+    void sqlWhere();
+    void sqlEscapesWildcards();
+
+    // ========== Planner ==========
+    void planDrivesFromMostSelectiveTerm();
+    void planNeverDrivesFromNegatedTerm();
+    void executeShortCircuits();
+    void executeNegationOnlyScansEverything();
+    void executeVerifiesTrigramCandidates();
+    void executeShortValueScans();
+    void executeEmptyQuery();
+    void executeFoldsCaseLikeTheIndex();
+
+private:
+    // catalog: Small library shared by the planner tests
+    static SearchIndex catalog();
+};
+
+// ============================================================================
+// PARSER
+// ============================================================================
+
+void tst_SearchQuery::parseFieldsAndPhrases()
+{
+    const SearchQuery query = SearchQuery::parse("author:King status:loaned \"Dark Tower\" -contact:John");
+    const QList<SearchTerm> &terms = query.terms();
+    QCOMPARE(terms.count(), 4);
+
+    QCOMPARE(terms[0].field, SearchTerm::Author);
+    QCOMPARE(terms[0].value, QString("king"));
+    QVERIFY(!terms[0].negated);
+
+    QCOMPARE(terms[1].field, SearchTerm::Status);
+    QCOMPARE(terms[1].value, QString("LOANED"));
+
+    QCOMPARE(terms[2].field, SearchTerm::Any);
+    QCOMPARE(terms[2].value, QString("dark tower"));
+
+    QCOMPARE(terms[3].field, SearchTerm::Contact);
+    QCOMPARE(terms[3].value, QString("john"));
+    QVERIFY(terms[3].negated);
+}
+
+// parseDanglingField: "author:" with nothing after it adds no term, and
+// does not swallow the next word
+void tst_SearchQuery::parseDanglingField()
+{
+    QVERIFY(SearchQuery::parse("author:").isEmpty());
+    QVERIFY(SearchQuery::parse("-author:").isEmpty());
+
+    const SearchQuery query = SearchQuery::parse("author: king");
+    QCOMPARE(query.terms().count(), 1);
+    QCOMPARE(query.terms()[0].field, SearchTerm::Any);
+    QCOMPARE(query.terms()[0].value, QString("king"));
+}
+
+// parseUnclosedQuote: The phrase runs to the end of the input
+void tst_SearchQuery::parseUnclosedQuote()
+{
+    const SearchQuery query = SearchQuery::parse("status:shelf title:\"the dark tow");
+    QCOMPARE(query.terms().count(), 2);
+    QCOMPARE(query.terms()[1].field, SearchTerm::Title);
+    QCOMPARE(query.terms()[1].value, QString("the dark tow"));
+
+    QVERIFY(SearchQuery::parse("\"").isEmpty());
+    QVERIFY(SearchQuery::parse("title:\"   ").isEmpty());
+}
+
+// parseLoneMinus: A "-" on its own is neither a term nor a negation of the
+// next word
+void tst_SearchQuery::parseLoneMinus()
+{
+    QVERIFY(SearchQuery::parse("-").isEmpty());
+    QVERIFY(SearchQuery::parse("  -  ").isEmpty());
+
+    const SearchQuery query = SearchQuery::parse("dark - tower");
+    QCOMPARE(query.terms().count(), 2);
+    QCOMPARE(query.terms()[0].value, QString("dark"));
+    QVERIFY(!query.terms()[0].negated);
+    QCOMPARE(query.terms()[1].value, QString("tower"));
+    QVERIFY(!query.terms()[1].negated);
+
+    // Hyphens inside a word are part of it
+    const SearchQuery hyphenated = SearchQuery::parse("spider-man");
+    QCOMPARE(hyphenated.terms().count(), 1);
+    QCOMPARE(hyphenated.terms()[0].value, QString("spider-man"));
+    QVERIFY(!hyphenated.terms()[0].negated);
+}
+
+void tst_SearchQuery::parseNegationOnly()
+{
+    const SearchQuery query = SearchQuery::parse("-status:shelf -\"dark tower\"");
+    QCOMPARE(query.terms().count(), 2);
+    QCOMPARE(query.terms()[0].field, SearchTerm::Status);
+    QCOMPARE(query.terms()[0].value, QString("SHELF"));
+    QVERIFY(query.terms()[0].negated);
+    QCOMPARE(query.terms()[1].value, QString("dark tower"));
+    QVERIFY(query.terms()[1].negated);
+}
+
+// parseUnknownField: Unknown prefixes are searched for literally
+void tst_SearchQuery::parseUnknownField()
+{
+    const SearchQuery query = SearchQuery::parse("re:zero", SearchTerm::Title);
+    QCOMPARE(query.terms().count(), 1);
+    QCOMPARE(query.terms()[0].field, SearchTerm::Title);
+    QCOMPARE(query.terms()[0].value, QString("re:zero"));
+}
+
+// ============================================================================
+// SQL TRANSLATION
+// ============================================================================
+
+void tst_SearchQuery::sqlWhere()
+{
+    QVariantList bindValues;
+    const QString where = SearchQuery::parse("author:king -\"dark tower\" status:loaned").toSqlWhere(bindValues);
+
+    QCOMPARE(where, QString("author ILIKE ? ESCAPE '\\' AND "
+                            "NOT (title ILIKE ? ESCAPE '\\' OR author ILIKE ? ESCAPE '\\') AND "
+                            "status = ?"));
+    QCOMPARE(bindValues, QVariantList({ "%king%", "%dark tower%", "%dark tower%", "LOANED" }));
+}
+
+// sqlEscapesWildcards: "%", "_" and "\" in a value match themselves only
+void tst_SearchQuery::sqlEscapesWildcards()
+{
+    QVariantList bindValues;
+    const QString where = SearchQuery::parse("title:100% contact:_x\\y").toSqlWhere(bindValues);
+
+    QCOMPARE(where, QString("title ILIKE ? ESCAPE '\\' AND "
+                            "(COALESCE(contact_name, '') ILIKE ? ESCAPE '\\' "
+                            "OR COALESCE(contact_number, '') ILIKE ? ESCAPE '\\')"));
+    QCOMPARE(bindValues, QVariantList({ "%100\\%%", "%\\_x\\\\y%", "%\\_x\\\\y%" }));
+
+    // Values never reach the SQL text
+    QVERIFY(!where.contains("100"));
+}
+
+// ============================================================================
+// PLANNER
+// ============================================================================
+
+SearchIndex tst_SearchQuery::catalog()
+{
+    QList<Book> books = {
+        { 1, "The Dark Tower", "Stephen King", "SHELF", "", "" },
+        { 2, "The Dark Tower II", "Stephen King", "LOANED", "John", "555-0101" },
+        { 3, "It", "Stephen King", "SHELF", "", "" },
+        { 4, "From a Buick 8", "Stephen King", "SHELF", "", "" },
+        { 5, "Dark Matter", "Blake Crouch", "SHELF", "", "" },
+        { 6, "Tower of Dawn", "Sarah J. Maas", "BORROWED", "Mary", "555-0102" },
+        { 7, "Darkly Dreaming Dexter", "Jeff Lindsay", "SHELF", "", "" },
+        { 8, "The Stand", "Stephen King", "SHELF", "", "" },
+    };
+    return SearchIndex(std::make_shared<const CatalogSnapshot>(books));
+}
+
+// planDrivesFromMostSelectiveTerm: One LOANED book against four "dark"
+// titles, so the status bitmap drives
+void tst_SearchQuery::planDrivesFromMostSelectiveTerm()
+{
+    const SearchIndex index = catalog();
+    const SearchQuery query = SearchQuery::parse("dark status:loaned");
+
+    QCOMPARE(index.estimateMatches(query.terms()[1]), 1);
+    QCOMPARE(index.plan(query).first(), 1);
+    QCOMPARE(titles(index.execute(query)), QStringList({ "The Dark Tower II" }));
+}
+
+// planNeverDrivesFromNegatedTerm: Excluding SHELF is the most selective
+// term, but only a positive term can produce candidates
+void tst_SearchQuery::planNeverDrivesFromNegatedTerm()
+{
+    const SearchIndex index = catalog();
+    const SearchQuery query = SearchQuery::parse("-status:shelf tower");
+
+    QCOMPARE(index.plan(query), QList<int>({ 1, 0 }));
+    QCOMPARE(titles(index.execute(query)), QStringList({ "The Dark Tower II", "Tower of Dawn" }));
+}
+
+// executeShortCircuits: A trigram missing from the index proves there is
+// no match, whatever the other terms are
+void tst_SearchQuery::executeShortCircuits()
+{
+    const SearchIndex index = catalog();
+    const SearchQuery query = SearchQuery::parse("status:shelf title:zzz");
+
+    QCOMPARE(index.estimateMatches(query.terms()[1]), 0);
+    QCOMPARE(index.plan(query).first(), 1);
+    QVERIFY(index.execute(query).isEmpty());
+}
+
+void tst_SearchQuery::executeNegationOnlyScansEverything()
+{
+    const SearchIndex index = catalog();
+
+    QCOMPARE(titles(index.execute(SearchQuery::parse("-status:shelf"))),
+             QStringList({ "The Dark Tower II", "Tower of Dawn" }));
+    QCOMPARE(index.execute(SearchQuery::parse("-author:king -dark")).count(), 1);
+    QVERIFY(index.execute(SearchQuery::parse("-status:shelf -status:loaned -status:borrowed")).isEmpty());
+}
+
+// executeVerifiesTrigramCandidates: Every trigram of "ly dex" occurs in
+// "Darkly Dreaming Dexter", but the phrase itself does not
+void tst_SearchQuery::executeVerifiesTrigramCandidates()
+{
+    const SearchIndex index = catalog();
+
+    QCOMPARE(index.candidateRows(SearchQuery::parse("title:\"ly dex\"").terms()[0]), QList<int>({ 6 }));
+    QVERIFY(index.execute(SearchQuery::parse("title:\"ly dex\"")).isEmpty());
+    QCOMPARE(titles(index.execute(SearchQuery::parse("title:\"ly dre\""))),
+             QStringList({ "Darkly Dreaming Dexter" }));
+}
+
+// executeShortValueScans: Values shorter than a trigram cannot use the
+// index and fall back to a scan ("8" matches "From a Buick 8")
+void tst_SearchQuery::executeShortValueScans()
+{
+    const SearchIndex index = catalog();
+    const SearchQuery query = SearchQuery::parse("title:8");
+
+    QCOMPARE(index.estimateMatches(query.terms()[0]), 8);
+    QCOMPARE(titles(index.execute(query)), QStringList({ "From a Buick 8" }));
+}
+
+void tst_SearchQuery::executeEmptyQuery()
+{
+    const SearchIndex index = catalog();
+    QVERIFY(index.execute(SearchQuery::parse("")).isEmpty());
+    QVERIFY(index.execute(SearchQuery::parse("author: -")).isEmpty());
+}
+
+// executeFoldsCaseLikeTheIndex: A typed final sigma folds to the same
+// letter as the capital sigma in the title, in the index and in matches(),
+// so the planner must not short-circuit to no results
+void tst_SearchQuery::executeFoldsCaseLikeTheIndex()
+{
+    const SearchIndex index(std::make_shared<const CatalogSnapshot>(QList<Book>{
+        { 1, "ΤΕΛΟΣ", "Νίκος Καζαντζάκης", "SHELF", "", "" },
+        { 2, "The Stand", "Stephen King", "SHELF", "", "" },
+    }));
+
+    const SearchQuery query = SearchQuery::parse("title:τελος");
+    QCOMPARE(query.terms()[0].value, QString("τελοσ"));
+    QCOMPARE(index.estimateMatches(query.terms()[0]), 1);
+    QCOMPARE(titles(index.execute(query)), QStringList({ "ΤΕΛΟΣ" }));
+
+    QCOMPARE(titles(index.execute(SearchQuery::parse("THE STAND"))), QStringList({ "The Stand" }));
+}
+
+QTEST_APPLESS_MAIN(tst_SearchQuery)
+#include "tst_searchquery.moc"